@@ -0,0 +1,718 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <new>
+#include <unistd.h>
+#include "sudoku.h"
+#include "solver.h"
+#include "generator.h"
+#include "grader.h"
+#include "savestore.h"
+#include "journal.h"
+#include "simd.h"
+#include "grid.h"
+#include "render.h"
+#include "canonical.h"
+using namespace std;
+
+typedef array<uint8_t, 81> Puzzle;
+
+// Every heap allocation made by the benchmarked code passes through here
+static atomic<long> allocations(0);
+
+void* operator new(size_t size)
+{
+    allocations.fetch_add(1, memory_order_relaxed);
+    void* p = malloc(size ? size : 1);
+    if (!p) throw bad_alloc();
+    return p;
+}
+
+// Out of line, so GCC does not inline the free next to the operator new
+// it pairs with and flag it as a mismatched deallocation
+__attribute__((noinline)) void operator delete(void* p) noexcept
+{
+    free(p);
+}
+
+__attribute__((noinline)) void operator delete(void* p, size_t) noexcept
+{
+    free(p);
+}
+
+// A named puzzle set, loaded from one 81-character puzzle per line
+struct Corpus {
+    string name;
+    vector<Puzzle> puzzles;
+};
+
+// One finished benchmark
+struct BenchResult {
+    string name;
+    long ops;
+    double seconds;
+    long allocs;
+};
+
+struct BenchOptions {
+    double minTime = 0.5;                        // Seconds each benchmark runs for at least
+    const char* filter = nullptr;                // Only names containing this
+    const char* json = nullptr;                  // JSON output file
+    vector<SolverStrategy> strategies = { SOLVER_BACKTRACK, SOLVER_BITMASK, SOLVER_DLX };
+    bool fullBacktrack = false;                  // Backtracker on every corpus, not just easy
+};
+
+static BenchOptions options;
+static vector<BenchResult> results;
+static volatile long sink;                       // Keeps benchmarked results alive
+
+/**
+ * Parses an 81-character puzzle line ('0' or '.' for empty cells)
+ * @param line Text to parse
+ * @param grid [out] Parsed puzzle
+ * @return True if the line held a complete puzzle, false otherwise
+ */
+static bool parsePuzzle(const string& line, Puzzle& grid)
+{
+    if (line.size() < 81) return false;
+    for (int i = 0; i < 81; i++)
+    {
+        char ch = line[i];
+        if (ch == '.') ch = '0';
+        if (ch < '0' || ch > '9') return false;
+        grid[i] = ch - '0';
+    }
+    return true;
+}
+
+/**
+ * Loads a corpus file
+ * @param path File with one puzzle per line
+ * @param name Name used in benchmark names
+ * @param corpus [out] Loaded corpus
+ * @return False if the file cannot be read or holds no puzzles
+ */
+static bool loadCorpus(const string& path, const string& name, Corpus& corpus)
+{
+    ifstream file(path);
+    if (!file.is_open()) return false;
+    corpus.name = name;
+    corpus.puzzles.clear();
+    string line;
+    Puzzle grid;
+    while (getline(file, line))
+    {
+        if (parsePuzzle(line, grid)) corpus.puzzles.push_back(grid);
+    }
+    return !corpus.puzzles.empty();
+}
+
+/**
+ * Runs one benchmark: op(i) is called with i = 0, 1, 2, ... in doubling
+ * batches until the minimum time has passed, so the clock is read rarely
+ * for fast ops and slow ops still run at least once
+ * @param name Benchmark name (group/variant/corpus)
+ * @param op Operation to time; its return value is kept alive through sink
+ */
+template <typename Op>
+static void runBench(const string& name, Op op)
+{
+    if (options.filter && name.find(options.filter) == string::npos) return;
+
+    long result = op(0);                         // Warm-up: first-use tables and caches
+    long ops = 0;
+    long batch = 1;
+    double seconds = 0;
+    long allocsBefore = allocations.load();
+    auto start = chrono::steady_clock::now();
+    while (seconds < options.minTime)
+    {
+        for (long i = 0; i < batch; i++)
+        {
+            result += op(ops + i);
+        }
+        ops += batch;
+        batch *= 2;
+        seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    }
+    sink = result;
+
+    BenchResult bench = { name, ops, seconds, allocations.load() - allocsBefore };
+    results.push_back(bench);
+    printf("%-32s %12ld %14.1f %14.0f %10.2f\n", name.c_str(), ops, seconds * 1e9 / ops, ops / seconds,
+           (double)bench.allocs / ops);
+    fflush(stdout);
+}
+
+/**
+ * Solver, grading and hint benchmarks over one corpus; one op is one puzzle
+ */
+static void benchCorpus(const Corpus& corpus)
+{
+    const vector<Puzzle>& puzzles = corpus.puzzles;
+    size_t count = puzzles.size();
+    uint8_t solution[81];
+
+    for (SolverStrategy strategy : options.strategies)
+    {
+        // The backtracker needs seconds per hard puzzle
+        if (strategy == SOLVER_BACKTRACK && corpus.name != "easy" && !options.fullBacktrack) continue;
+        string engine = strategyName(strategy);
+        runBench("solve/" + engine + "/" + corpus.name, [&](long i) {
+            return countSolutionsWith(strategy, puzzles[i % count].data(), 1, solution);
+        });
+        runBench("unique/" + engine + "/" + corpus.name, [&](long i) {
+            return countSolutionsWith(strategy, puzzles[i % count].data(), 2, solution);
+        });
+    }
+
+    runBench("grade/" + corpus.name, [&](long i) {
+        return (int)gradePuzzle(puzzles[i % count].data()).difficulty;
+    });
+
+    HintEngine hints;
+    runBench("hint/load+next/" + corpus.name, [&](long i) {
+        Hint hint;
+        hints.load(puzzles[i % count].data());
+        return hints.nextHint(hint) ? hint.cell : -1;
+    });
+}
+
+/**
+ * Generic GridSolver benchmarks on one corpus of BOX-sized puzzles
+ * @param path Corpus file, one puzzle per line
+ * @param name Corpus name used in benchmark names
+ */
+template <int BOX>
+static void benchGrid(const string& path, const string& name)
+{
+    typedef GridTraits<BOX> T;
+    vector<array<uint8_t, T::CELLS> > puzzles;
+    array<uint8_t, T::CELLS> grid;
+    ifstream file(path);
+    string line;
+    while (getline(file, line))
+    {
+        if (parseGrid<BOX>(line.data(), line.size(), grid.data())) puzzles.push_back(grid);
+    }
+    if (puzzles.empty())
+    {
+        cerr << "Warning: Could not load " << path << "\n";
+        return;
+    }
+
+    size_t count = puzzles.size();
+    GridSolver<BOX> solver;
+    runBench("solve/grid/" + name, [&](long i) {
+        solver.load(puzzles[i % count].data());
+        return solver.countSolutions(1);
+    });
+    runBench("unique/grid/" + name, [&](long i) {
+        solver.load(puzzles[i % count].data());
+        return solver.countSolutions(2);
+    });
+}
+
+/**
+ * Variant rule set benchmarks on puzzles generated under the same rules;
+ * solve/variant/classic is the baseline the others are compared to
+ * @param name Variant name used in benchmark names
+ */
+template <typename Rules>
+static void benchVariant(const string& name)
+{
+    GridGenerator<3, Rules> generator(1);
+    vector<array<uint8_t, 81> > puzzles(64);
+    uint8_t solution[81];
+    for (auto& puzzle : puzzles)
+    {
+        generator.randomSolution(solution);
+        generator.removeClues(solution, puzzle.data(), 55);
+    }
+
+    size_t count = puzzles.size();
+    GridSolver<3, Rules> solver;
+    runBench("solve/variant/" + name, [&](long i) {
+        solver.load(puzzles[i % count].data());
+        return solver.countSolutions(1);
+    });
+    runBench("generate/variant/" + name, [&](long i) {
+        generator.randomSolution(solution);
+        return generator.removeClues(solution, puzzles[i % count].data(), 55);
+    });
+}
+
+/**
+ * Generation benchmarks; one op is one grid or puzzle
+ */
+static void benchGeneration()
+{
+    PuzzleGenerator generator(1);
+    uint8_t grid[81];
+    generator.randomSolution(grid);
+
+    runBench("generate/solution", [&](long) {
+        generator.randomSolution(grid);
+        return grid[0];
+    });
+    runBench("generate/shuffle", [&](long) {
+        generator.shuffleSolution(grid);
+        return grid[0];
+    });
+
+    SudokuGame game(1);
+    runBench("generate/sudoku", [&](long) {
+        game.generateSudoku();
+        return game.getSolutionAt(0, 0);
+    });
+
+    uint8_t puzzle[81];
+    runBench("generate/minimal", [&](long) {
+        generator.shuffleSolution(grid);
+        return generator.minimalPuzzle(grid, puzzle);
+    });
+}
+
+/**
+ * Validation benchmarks: single moves and whole grids
+ */
+static void benchValidation(const Corpus& corpus)
+{
+    SudokuGame game(1);
+    runBench("validate/isValid", [&](long i) {
+        return (int)game.isValid((i / 9) % 9, i % 9, i % 9 + 1);
+    });
+
+    uint8_t solved[81];
+    countSolutionsWith(SOLVER_BITMASK, corpus.puzzles[0].data(), 1, solved);
+    runBench("validate/isSolvedGrid", [&](long) {
+        return (int)isSolvedGrid(solved);
+    });
+
+    size_t count = corpus.puzzles.size();
+    runBench("validate/hasConflicts/" + corpus.name, [&](long i) {
+        return (int)hasConflicts(corpus.puzzles[i % count].data());
+    });
+
+    uint16_t candidates[81];
+    runBench("validate/candidates/" + corpus.name, [&](long i) {
+        computeCandidates(corpus.puzzles[i % count].data(), candidates);
+        return candidates[0];
+    });
+}
+
+/**
+ * Deduplication benchmarks: canonical form of one puzzle, and an index
+ * lookup for a fingerprint already present
+ */
+static void benchCanonical(const Corpus& corpus)
+{
+    size_t count = corpus.puzzles.size();
+    uint8_t canonical[81];
+    runBench("canonical/form/" + corpus.name, [&](long i) {
+        canonicalForm(corpus.puzzles[i % count].data(), canonical);
+        return canonical[80];
+    });
+
+    PuzzleIndex index(count);
+    vector<uint64_t> hashes;
+    for (const Puzzle& puzzle : corpus.puzzles)
+    {
+        hashes.push_back(canonicalHash(puzzle.data()));
+        index.insert(hashes.back());
+    }
+    runBench("canonical/index-insert/" + corpus.name, [&](long i) {
+        return (int)index.insert(hashes[i % count]);
+    });
+}
+
+/**
+ * Game session benchmarks through the headless move API; one op is one move
+ */
+static void benchSession()
+{
+    PuzzleGenerator generator(1);
+    SudokuGame fresh(1);
+    int empty[81];
+    int emptyCount = 0;
+    for (int cell = 0; cell < 81; cell++)
+    {
+        if (fresh.getCell(cell / 9, cell % 9) == 0) empty[emptyCount++] = cell;
+    }
+
+    // Game start: generating on the spot versus taking a pooled puzzle
+    uint64_t seed = 1;
+    runBench("session/new", [&](long) {
+        SudokuGame started(seed++);
+        return started.getCell(0, 0);
+    });
+    PuzzlePool pool(64, 0);
+    PooledPuzzle pooled;
+    pooled.seed = 0;
+    generator.randomGame(pooled.solution, pooled.puzzle);
+    pooled.difficulty = GRADE_EASY;
+    pool.add(pooled);
+    runBench("session/new-pooled", [&](long) {
+        pool.take(GRADE_EASY, pooled);
+        SudokuGame started(pooled);
+        pool.add(pooled);                        // Stands in for the refill threads
+        return started.getCell(0, 0);
+    });
+
+    // Correct moves until the board is solved, then start over from a copy
+    SudokuGame game = fresh;
+    int next = 0;
+    runBench("session/move", [&](long) {
+        if (next == emptyCount)
+        {
+            game = fresh;
+            next = 0;
+        }
+        int cell = empty[next++];
+        return (int)game.makeMove(cell / 9 + 1, cell % 9 + 1, game.getSolutionAt(cell / 9, cell % 9));
+    });
+
+    // Undo and redo from the solved board: undo back to the start, then
+    // redo to the end, one move per op
+    SudokuGame played = fresh;
+    played.markBranch("start");
+    for (int k = 0; k < emptyCount; k++)
+    {
+        played.makeMove(empty[k] / 9 + 1, empty[k] % 9 + 1, played.getSolutionAt(empty[k] / 9, empty[k] % 9));
+    }
+    played.markBranch("end");
+    bool undoing = true;
+    runBench("session/undo-redo", [&](long) {
+        if (undoing && played.getUndoDepth() == 0) undoing = false;
+        if (!undoing && played.getRedoDepth() == 0) undoing = true;
+        return (int)(undoing ? played.undo() : played.redo());
+    });
+
+    // Jumps between the empty and the solved board; one op walks every move
+    // of the game (emptyCount deltas)
+    played.restoreBranch("end");
+    runBench("session/branch-restore", [&](long i) {
+        return (int)played.restoreBranch(i % 2 ? "end" : "start");
+    });
+
+    // Rejected moves leave the session unchanged: each empty cell gets a
+    // digit already given in its row
+    int conflict[81];
+    for (int i = 0; i < emptyCount; i++)
+    {
+        int row = empty[i] / 9;
+        conflict[i] = 0;
+        for (int col = 0; col < 9 && conflict[i] == 0; col++) conflict[i] = fresh.getCell(row, col);
+    }
+    game = fresh;
+    runBench("session/move-conflict", [&](long i) {
+        int k = i % emptyCount;
+        return (int)game.makeMove(empty[k] / 9 + 1, empty[k] % 9 + 1, conflict[k]);
+    });
+}
+
+/**
+ * Console frame benchmarks; one op renders one frame into the buffer
+ * without writing it
+ */
+static void benchRender()
+{
+    SudokuGame game(1);
+    BoardRenderer framed;
+    runBench("render/frame", [&](long) {
+        return framed.renderFrame(game);
+    });
+
+    // A spectator's view of play: consecutive boards differ by one digit
+    SudokuGame moved = game;
+    for (int cell = 0; cell < 81; cell++)
+    {
+        if (moved.getCell(cell / 9, cell % 9) != 0) continue;
+        moved.makeMove(cell / 9 + 1, cell % 9 + 1, moved.getSolutionAt(cell / 9, cell % 9));
+        break;
+    }
+    BoardRenderer anchored(1);
+    anchored.renderFrame(game);
+    runBench("render/changes", [&](long i) {
+        return anchored.renderChanges(i % 2 ? game : moved);
+    });
+}
+
+/**
+ * Save and load benchmarks: record encoding, the mapped store and the
+ * move journal
+ */
+static void benchSaveLoad()
+{
+    char path[] = "/tmp/sudoku-bench-XXXXXX";
+    int fd = mkstemp(path);
+    if (fd < 0)
+    {
+        cerr << "Skipping save benchmarks: no temporary file\n";
+        return;
+    }
+    close(fd);
+    unlink(path);
+
+    const uint64_t SLOTS = 1 << 16;
+    SaveStore store;
+    if (!store.open(path, SLOTS))
+    {
+        cerr << "Skipping save benchmarks: could not create " << path << "\n";
+        return;
+    }
+
+    SudokuGame game(1);
+    GameData data;
+    game.saveGame(store, 0);
+    store.load(0, data);
+
+    SaveRecord record;
+    runBench("save/encode", [&](long) {
+        encodeSave(data, record);
+        return record.checksum;
+    });
+    runBench("save/decode", [&](long) {
+        return (int)decodeSave(record, data);
+    });
+    runBench("save/store", [&](long i) {
+        return (int)store.save(i % SLOTS, data);
+    });
+    runBench("save/load", [&](long i) {
+        return (int)store.load(i % SLOTS, data);
+    });
+    runBench("save/game-load", [&](long i) {
+        return (int)game.loadGame(store, i % SLOTS);
+    });
+
+    // One op is one journaled move; moves are committed in groups of 64,
+    // as a server commits every move of an event-loop pass at once
+    string journalPath = string(path) + ".journal";
+    MoveJournal journal(store);
+    if (journal.open(journalPath.c_str()) >= 0)
+    {
+        uint32_t ticket = journal.snapshot(1, data);
+        runBench("journal/move", [&](long i) {
+            bool appended = journal.append(1, ticket, JOURNAL_PLACE, i % 81, 1 + i % 9, data);
+            if (i % 64 == 63) journal.commit();
+            if (journal.size() > (1 << 20)) journal.compact();
+            return (int)appended;
+        });
+        journal.close();
+    }
+    unlink(journalPath.c_str());
+
+    store.close();
+    unlink(path);
+}
+
+/**
+ * Writes all results as JSON, one benchmark object per line so that
+ * --compare (and line-based diff tools) can read it back
+ * @param path Output file
+ * @return False if the file cannot be written
+ */
+static bool writeJson(const char* path)
+{
+    FILE* out = fopen(path, "w");
+    if (!out) return false;
+
+    char date[32];
+    time_t now = time(nullptr);
+    strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", localtime(&now));
+    fprintf(out, "{\n  \"context\": {\"date\": \"%s\", \"simd\": \"%s\", \"min_time\": %.3f},\n",
+            date, simdKernelName(), options.minTime);
+    fprintf(out, "  \"benchmarks\": [\n");
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        const BenchResult& r = results[i];
+        fprintf(out, "    {\"name\": \"%s\", \"iterations\": %ld, \"ns_per_op\": %.2f, \"ops_per_sec\": %.2f, \"allocs_per_op\": %.4f}%s\n",
+                r.name.c_str(), r.ops, r.seconds * 1e9 / r.ops, r.ops / r.seconds, (double)r.allocs / r.ops,
+                i + 1 < results.size() ? "," : "");
+    }
+    fprintf(out, "  ]\n}\n");
+    fclose(out);
+    return true;
+}
+
+/**
+ * Reads name and ns_per_op of every benchmark from a file written by writeJson
+ * @param path JSON file
+ * @param names [out] Benchmark names
+ * @param nsPerOp [out] Matching timings
+ * @return False if the file cannot be read
+ */
+static bool readJson(const char* path, vector<string>& names, vector<double>& nsPerOp)
+{
+    ifstream file(path);
+    if (!file.is_open()) return false;
+    string line;
+    while (getline(file, line))
+    {
+        size_t name = line.find("\"name\": \"");
+        size_t ns = line.find("\"ns_per_op\": ");
+        if (name == string::npos || ns == string::npos) continue;
+        name += 9;
+        names.push_back(line.substr(name, line.find('"', name) - name));
+        nsPerOp.push_back(atof(line.c_str() + ns + 13));
+    }
+    return true;
+}
+
+/**
+ * Compares two result files benchmark by benchmark
+ * @param basePath Baseline results
+ * @param newPath Results to check
+ * @param threshold Slowdown (percent) that counts as a regression
+ * @return Process exit status: 1 if any benchmark regressed
+ */
+static int compareResults(const char* basePath, const char* newPath, double threshold)
+{
+    vector<string> baseNames, newNames;
+    vector<double> baseNs, newNs;
+    if (!readJson(basePath, baseNames, baseNs) || !readJson(newPath, newNames, newNs))
+    {
+        cerr << "Error: Could not read " << basePath << " or " << newPath << "\n";
+        return 1;
+    }
+
+    int regressions = 0;
+    printf("%-32s %14s %14s %9s\n", "benchmark", "base ns/op", "new ns/op", "change");
+    for (size_t i = 0; i < newNames.size(); i++)
+    {
+        for (size_t j = 0; j < baseNames.size(); j++)
+        {
+            if (baseNames[j] != newNames[i]) continue;
+            double change = (newNs[i] - baseNs[j]) * 100.0 / baseNs[j];
+            bool regressed = change > threshold;
+            regressions += regressed;
+            printf("%-32s %14.1f %14.1f %+8.1f%%%s\n", newNames[i].c_str(), baseNs[j], newNs[i], change,
+                   regressed ? "  REGRESSION" : "");
+            break;
+        }
+    }
+    printf("%d regression(s) over %.0f%%\n", regressions, threshold);
+    return regressions > 0 ? 1 : 0;
+}
+
+/**
+ * Prints command-line usage
+ */
+static void printUsage()
+{
+    cerr << "Usage: sudoku-bench [--corpus DIR] [--strategy NAME] [--filter TEXT] [--min-time SEC] [--json FILE] [puzzle-file]\n"
+         << "       sudoku-bench --compare BASE.json NEW.json [--threshold PCT]\n"
+         << "  --corpus DIR     directory with easy.txt, hard.txt, 17clue.txt, 16x16.txt and\n"
+         << "                   25x25.txt (default: corpus)\n"
+         << "  --strategy NAME  only benchmark one solver engine (backtrack then also runs\n"
+         << "                   on the hard corpora, which takes seconds per puzzle)\n"
+         << "  --filter TEXT    only run benchmarks whose name contains TEXT\n"
+         << "  --min-time SEC   minimum time per benchmark (default 0.5)\n"
+         << "  --json FILE      also write results as JSON\n"
+         << "  --compare        report per-benchmark change between two JSON files,\n"
+         << "                   exit 1 if any is slower by more than --threshold (default 10)\n";
+}
+
+/**
+ * Benchmark entry point
+ */
+int main(int argc, char* argv[])
+{
+    string corpusDir = "corpus";
+    const char* path = nullptr;
+    const char* compareBase = nullptr;
+    const char* compareNew = nullptr;
+    double threshold = 10;
+
+    for (int i = 1; i < argc; i++)
+    {
+        bool hasValue = i + 1 < argc;
+        SolverStrategy strategy;
+        if (strcmp(argv[i], "--strategy") == 0 && hasValue)
+        {
+            if (!parseStrategy(argv[++i], strategy))
+            {
+                cerr << "Unknown strategy: " << argv[i] << "\n";
+                return 1;
+            }
+            options.strategies.assign(1, strategy);
+            options.fullBacktrack = true;
+        }
+        else if (strcmp(argv[i], "--corpus") == 0 && hasValue) corpusDir = argv[++i];
+        else if (strcmp(argv[i], "--filter") == 0 && hasValue) options.filter = argv[++i];
+        else if (strcmp(argv[i], "--min-time") == 0 && hasValue) options.minTime = atof(argv[++i]);
+        else if (strcmp(argv[i], "--json") == 0 && hasValue) options.json = argv[++i];
+        else if (strcmp(argv[i], "--threshold") == 0 && hasValue) threshold = atof(argv[++i]);
+        else if (strcmp(argv[i], "--compare") == 0 && i + 2 < argc)
+        {
+            compareBase = argv[++i];
+            compareNew = argv[++i];
+        }
+        else if (argv[i][0] != '-') path = argv[i];
+        else
+        {
+            printUsage();
+            return 1;
+        }
+    }
+    if (compareBase) return compareResults(compareBase, compareNew, threshold);
+
+    vector<Corpus> corpora;
+    Corpus corpus;
+    for (const char* name : { "easy", "hard", "17clue" })
+    {
+        if (loadCorpus(corpusDir + "/" + name + ".txt", name, corpus)) corpora.push_back(corpus);
+        else cerr << "Warning: Could not load " << corpusDir << "/" << name << ".txt\n";
+    }
+    if (path)
+    {
+        if (!loadCorpus(path, "file", corpus))
+        {
+            cerr << "Error: Could not read puzzles from " << path << "\n";
+            return 1;
+        }
+        corpora.push_back(corpus);
+    }
+    if (corpora.empty())
+    {
+        cerr << "Nothing to benchmark\n";
+        return 1;
+    }
+
+    printf("%-32s %12s %14s %14s %10s\n", "benchmark", "ops", "ns/op", "ops/sec", "allocs/op");
+    for (const Corpus& c : corpora)
+    {
+        benchCorpus(c);
+    }
+    benchGrid<3>(corpusDir + "/hard.txt", "hard");    // Same puzzles as solve/bitmask/hard
+    benchGrid<4>(corpusDir + "/16x16.txt", "16x16");
+    benchGrid<5>(corpusDir + "/25x25.txt", "25x25");
+    benchVariant<ClassicRules<3> >(variantName(VARIANT_CLASSIC));
+    benchVariant<DiagonalRules>(variantName(VARIANT_DIAGONAL));
+    benchVariant<WindokuRules>(variantName(VARIANT_WINDOKU));
+    benchVariant<AntiKnightRules>(variantName(VARIANT_ANTIKNIGHT));
+    benchGeneration();
+    benchValidation(corpora[0]);
+    for (const Corpus& c : corpora)
+    {
+        benchCanonical(c);
+    }
+    benchSession();
+    benchRender();
+    benchSaveLoad();
+
+    if (options.json && !writeJson(options.json))
+    {
+        cerr << "Error: Could not write " << options.json << "\n";
+        return 1;
+    }
+    return 0;
+}
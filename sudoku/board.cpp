@@ -0,0 +1,41 @@
+#include "board.h"
+#include "simd.h"
+#include <cstring>
+
+/**
+ * Empties every cell and clears all fixed flags and masks
+ */
+void Board::clear()
+{
+    memset(this, 0, sizeof(Board));
+}
+
+/**
+ * Replaces all digits at once and rebuilds the unit masks in one pass
+ * Fixed flags are left unchanged
+ * @param values Digits in row-major order, 0 for empty
+ * @return False if a value is out of range or a unit repeats a digit
+ */
+bool Board::load(const uint8_t values[81])
+{
+    for (int cell = 0; cell < 81; cell++)
+    {
+        if (values[cell] > 9) return false;
+    }
+    memcpy(cells, values, sizeof(cells));
+
+    UnitScan scan;
+    scanUnits(cells, scan);
+    memcpy(rowMask, scan.rowMask, sizeof(rowMask));
+    memcpy(colMask, scan.colMask, sizeof(colMask));
+    memcpy(boxMask, scan.boxMask, sizeof(boxMask));
+    return !scan.conflict;
+}
+
+/**
+ * @return True if every cell holds a digit
+ */
+bool Board::isFull() const
+{
+    return memchr(cells, 0, sizeof(cells)) == nullptr;
+}
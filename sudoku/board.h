@@ -0,0 +1,117 @@
+#ifndef BOARD_H
+#define BOARD_H
+
+#include <cstdint>
+#include <type_traits>
+#include "tables.h"
+
+// Packed 9x9 board: one byte per cell, a 128-bit fixed-cell set and the
+// used-digit masks of every row, column and box (bit d-1 = digit d), kept in
+// sync on every edit. It is trivially copyable, so a snapshot is a plain
+// 152-byte copy instead of the ~730 bytes of three int/bool 9x9 arrays.
+struct Board {
+    uint64_t fixedBits[2];                       // Bit i set if cell i is fixed
+    uint16_t rowMask[9];                         // Digits used in each row
+    uint16_t colMask[9];                         // Digits used in each column
+    uint16_t boxMask[9];                         // Digits used in each 3x3 box
+    uint8_t cells[81];                           // Digits in row-major order, 0 for empty
+
+    void clear();                                // Empties every cell
+    bool load(const uint8_t values[81]);         // Replaces all digits, false on conflict
+    int get(int cell) const;                     // Digit in cell, 0 if empty
+    void set(int cell, int num);                 // Places digit in an empty cell
+    void erase(int cell);                        // Empties a cell
+    bool isFixed(int cell) const;                // Checks fixed flag
+    void setFixed(int cell, bool fixed);         // Sets fixed flag
+    uint16_t candidates(int cell) const;         // Digits not used by the cell's units
+    bool canPlace(int cell, int num) const;      // Checks num against the cell's units
+    bool isFull() const;                         // True if no cell is empty
+
+    static int index(int row, int col) { return row * 9 + col; }
+    static int rowOf(int cell) { return sudokuTables.cellUnits[cell][0]; }
+    static int colOf(int cell) { return sudokuTables.cellUnits[cell][1]; }
+    static int boxOf(int cell) { return sudokuTables.cellUnits[cell][2]; }
+};
+
+static_assert(std::is_trivially_copyable<Board>::value, "Board must stay snapshot-by-memcpy");
+
+/**
+ * @param cell Cell index (0-80)
+ * @return Digit in the cell, 0 if empty
+ */
+inline int Board::get(int cell) const
+{
+    return cells[cell];
+}
+
+/**
+ * Places a digit in an empty cell and marks it in the unit masks
+ * @param cell Cell index (0-80)
+ * @param num Digit to place (1-9)
+ */
+inline void Board::set(int cell, int num)
+{
+    const uint8_t* units = sudokuTables.cellUnits[cell];
+    uint16_t bit = 1 << (num - 1);
+    cells[cell] = num;
+    rowMask[units[0]] |= bit;
+    colMask[units[1]] |= bit;
+    boxMask[units[2]] |= bit;
+}
+
+/**
+ * Empties a cell and releases its digit in the unit masks
+ * @param cell Cell index (0-80)
+ */
+inline void Board::erase(int cell)
+{
+    if (cells[cell] == 0) return;
+    const uint8_t* units = sudokuTables.cellUnits[cell];
+    uint16_t bit = ~(1 << (cells[cell] - 1));
+    rowMask[units[0]] &= bit;
+    colMask[units[1]] &= bit;
+    boxMask[units[2]] &= bit;
+    cells[cell] = 0;
+}
+
+/**
+ * @param cell Cell index (0-80)
+ * @return True if the cell is fixed (given or solved)
+ */
+inline bool Board::isFixed(int cell) const
+{
+    return (fixedBits[cell >> 6] >> (cell & 63)) & 1;
+}
+
+/**
+ * @param cell Cell index (0-80)
+ * @param fixed New fixed flag
+ */
+inline void Board::setFixed(int cell, bool fixed)
+{
+    uint64_t bit = 1ULL << (cell & 63);
+    if (fixed) fixedBits[cell >> 6] |= bit;
+    else fixedBits[cell >> 6] &= ~bit;
+}
+
+/**
+ * @param cell Cell index (0-80)
+ * @return Mask of digits not used by the cell's row, column or box
+ */
+inline uint16_t Board::candidates(int cell) const
+{
+    const uint8_t* units = sudokuTables.cellUnits[cell];
+    return ~(rowMask[units[0]] | colMask[units[1]] | boxMask[units[2]]) & 0x1FF;
+}
+
+/**
+ * @param cell Cell index (0-80)
+ * @param num Digit to check (1-9)
+ * @return True if no unit of the cell already holds num
+ */
+inline bool Board::canPlace(int cell, int num) const
+{
+    return (candidates(cell) >> (num - 1)) & 1;
+}
+
+#endif
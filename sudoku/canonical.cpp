@@ -0,0 +1,350 @@
+#include "canonical.h"
+#include <cstdio>
+#include <cstring>
+#include <utility>
+
+using std::swap;
+
+namespace {
+
+// The six orders of three items
+const uint8_t PERMUTATIONS[6][3] = {
+    {0, 1, 2}, {0, 2, 1}, {1, 0, 2}, {1, 2, 0}, {2, 0, 1}, {2, 1, 0}
+};
+
+const int ARRANGEMENT_COUNT = 6 * 6 * 6 * 6;
+
+// Every column arrangement (stack order, then the order within each of the
+// three stacks, indexed in that nesting) as the source column of each
+// output column, and for each 3-bit given mask of a stack (bit 2 = first
+// column) the orders within the stack that move its givens to the right
+struct ArrangementTable {
+    uint8_t columns[ARRANGEMENT_COUNT][9];
+    uint8_t rightmost[8][6];
+    uint8_t rightmostCount[8];
+
+    ArrangementTable()
+    {
+        int n = 0;
+        for (int s = 0; s < 6; s++)
+            for (int a = 0; a < 6; a++)
+                for (int b = 0; b < 6; b++)
+                    for (int c = 0; c < 6; c++)
+                    {
+                        const int within[3] = {a, b, c};
+                        for (int k = 0; k < 3; k++)
+                        {
+                            for (int i = 0; i < 3; i++)
+                            {
+                                columns[n][3 * k + i] = 3 * PERMUTATIONS[s][k] + PERMUTATIONS[within[k]][i];
+                            }
+                        }
+                        n++;
+                    }
+        for (int mask = 0; mask < 8; mask++)
+        {
+            rightmostCount[mask] = 0;
+            for (int p = 0; p < 6; p++)
+            {
+                int reordered = 0;
+                for (int i = 0; i < 3; i++)
+                {
+                    if (mask & (4 >> PERMUTATIONS[p][i])) reordered |= 4 >> i;
+                }
+                if (reordered == (1 << __builtin_popcount(mask)) - 1) rightmost[mask][rightmostCount[mask]++] = p;
+            }
+        }
+    }
+};
+
+const ArrangementTable& arrangementTable()
+{
+    static const ArrangementTable table;
+    return table;
+}
+
+// Value standing for "no best row yet"; larger than any relabeled digit
+const uint8_t UNSET = 10;
+
+// Branch and bound over row orders for one orientation and column
+// arrangement. best holds the smallest grid seen so far; a row that is
+// smaller than best's row at the same depth replaces it and marks every
+// later best row unset, so the rest of that branch always completes a
+// new best.
+struct RowSearch {
+    const uint8_t* grid;                         // Orientation being searched
+    const uint8_t* columns;                      // Source column of each output column
+    uint8_t* best;                               // [in,out] Smallest grid so far
+
+    void search(int depth, int usedRows, int band, const uint8_t labels[10], int nextLabel)
+    {
+        if (depth == 9) return;
+        int first = depth % 3 == 0 ? 0 : 3 * band;
+        int last = depth % 3 == 0 ? 9 : 3 * band + 3;
+        for (int row = first; row < last; row++)
+        {
+            if (usedRows & (1 << row)) continue;
+            if (depth % 3 == 0 && (row % 3 != 0 || (usedRows & (7 << row)))) continue;
+            if (depth % 3 == 0)
+            {
+                // A band starts with any of its rows: try each in turn
+                for (int start = row; start < row + 3; start++)
+                {
+                    place(depth, start, usedRows, start / 3, labels, nextLabel);
+                }
+                continue;
+            }
+            place(depth, row, usedRows, band, labels, nextLabel);
+        }
+    }
+
+    void place(int depth, int row, int usedRows, int band, const uint8_t labels[10], int nextLabel)
+    {
+        uint8_t relabel[10];
+        memcpy(relabel, labels, sizeof(relabel));
+        uint8_t line[9];
+        const uint8_t* source = grid + 9 * row;
+        uint8_t* target = best + 9 * depth;
+        bool smaller = false;
+        for (int col = 0; col < 9; col++)
+        {
+            int digit = source[columns[col]];
+            if (digit && !relabel[digit]) relabel[digit] = nextLabel++;
+            line[col] = relabel[digit];
+            if (smaller) continue;
+            if (line[col] > target[col]) return;  // Most branches end at the first cells
+            smaller = line[col] < target[col];
+        }
+
+        if (smaller)
+        {
+            memcpy(target, line, 9);
+            if (depth < 8) memset(target + 9, UNSET, 81 - 9 * (depth + 1));
+        }
+        search(depth + 1, usedRows | (1 << row), band, relabel, nextLabel);
+    }
+};
+
+}
+
+/**
+ * Computes the canonical form of a grid. The first row of the result only
+ * depends on which of its cells are given, so the search starts from the
+ * rows and column arrangements that put the givens of some row as far
+ * right as possible, and orders the remaining rows by branch and bound.
+ * @param grid Digits, 0 for empty
+ * @param canonical [out] Smallest equivalent grid, digits relabeled by first appearance
+ */
+void canonicalForm(const uint8_t grid[81], uint8_t canonical[81])
+{
+    const ArrangementTable& table = arrangementTable();
+    uint8_t oriented[2][81];
+    for (int cell = 0; cell < 81; cell++)
+    {
+        oriented[0][cell] = grid[cell];
+        oriented[1][cell] = grid[(cell % 9) * 9 + cell / 9];
+    }
+
+    // The smallest first-row mask any row and arrangement gives: each
+    // stack's givens moved right, stacks in increasing order of givens
+    uint8_t stackMasks[2][9][3];
+    int rowMin[2][9];
+    int bestMask = 0x1FF;
+    for (int t = 0; t < 2; t++)
+    {
+        for (int row = 0; row < 9; row++)
+        {
+            uint8_t sorted[3];
+            for (int s = 0; s < 3; s++)
+            {
+                const uint8_t* cells = oriented[t] + 9 * row + 3 * s;
+                stackMasks[t][row][s] = (cells[0] ? 4 : 0) | (cells[1] ? 2 : 0) | (cells[2] ? 1 : 0);
+                sorted[s] = (1 << __builtin_popcount(stackMasks[t][row][s])) - 1;
+            }
+            if (sorted[0] > sorted[1]) swap(sorted[0], sorted[1]);
+            if (sorted[1] > sorted[2]) swap(sorted[1], sorted[2]);
+            if (sorted[0] > sorted[1]) swap(sorted[0], sorted[1]);
+            rowMin[t][row] = sorted[0] << 6 | sorted[1] << 3 | sorted[2];
+            if (rowMin[t][row] < bestMask) bestMask = rowMin[t][row];
+        }
+    }
+
+    // Search every row and arrangement that reaches it: stack orders with
+    // non-decreasing givens, and within each stack the orders that move
+    // its givens right
+    memset(canonical, UNSET, 81);
+    RowSearch search;
+    search.best = canonical;
+    const uint8_t noLabels[10] = {};
+    for (int t = 0; t < 2; t++)
+    {
+        search.grid = oriented[t];
+        for (int row = 0; row < 9; row++)
+        {
+            if (rowMin[t][row] != bestMask) continue;
+            const uint8_t* masks = stackMasks[t][row];
+            for (int s = 0; s < 6; s++)
+            {
+                const uint8_t* stacks = PERMUTATIONS[s];
+                int m0 = masks[stacks[0]], m1 = masks[stacks[1]], m2 = masks[stacks[2]];
+                if (__builtin_popcount(m0) > __builtin_popcount(m1) || __builtin_popcount(m1) > __builtin_popcount(m2)) continue;
+                for (int i = 0; i < table.rightmostCount[m0]; i++)
+                    for (int j = 0; j < table.rightmostCount[m1]; j++)
+                        for (int k = 0; k < table.rightmostCount[m2]; k++)
+                        {
+                            int a = ((s * 6 + table.rightmost[m0][i]) * 6 + table.rightmost[m1][j]) * 6 + table.rightmost[m2][k];
+                            search.columns = table.columns[a];
+                            search.place(0, row, 0, row / 3, noLabels, 1);
+                        }
+            }
+        }
+    }
+}
+
+/**
+ * Fingerprints a grid's equivalence class: equivalent grids always hash
+ * alike, different classes collide with probability about 2^-64
+ * @param grid Digits, 0 for empty
+ * @return Hash of the canonical form
+ */
+uint64_t canonicalHash(const uint8_t grid[81])
+{
+    uint8_t canonical[81];
+    canonicalForm(grid, canonical);
+    uint64_t hash = 0x9E3779B97F4A7C15ULL;
+    for (int start = 0; start < 81; start += 16)
+    {
+        uint64_t word = 0;
+        for (int cell = start; cell < start + 16 && cell < 81; cell++)
+        {
+            word = word << 4 | canonical[cell];
+        }
+        // splitmix64 finalizer over the running state
+        uint64_t z = hash ^ word;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        hash = z ^ (z >> 31);
+    }
+    return hash;
+}
+
+/**
+ * PuzzleIndex constructor
+ * @param expected Fingerprints expected, sizes the table to avoid growing
+ */
+PuzzleIndex::PuzzleIndex(size_t expected) : count(0)
+{
+    size_t size = 16;
+    while (size < 2 * expected) size <<= 1;
+    slots.assign(size, 0);
+}
+
+/**
+ * Doubles the table and reinserts every fingerprint
+ */
+void PuzzleIndex::grow()
+{
+    std::vector<uint64_t> old(slots.size() * 2, 0);
+    old.swap(slots);
+    count = 0;
+    for (uint64_t hash : old)
+    {
+        if (hash) insert(hash);
+    }
+}
+
+/**
+ * Adds a fingerprint
+ * @param hash Fingerprint from canonicalHash
+ * @return False if it was already present
+ */
+bool PuzzleIndex::insert(uint64_t hash)
+{
+    if (hash == 0) hash = 1;
+    if (2 * (count + 1) > slots.size()) grow();
+    size_t mask = slots.size() - 1;
+    for (size_t i = hash & mask; ; i = (i + 1) & mask)
+    {
+        if (slots[i] == hash) return false;
+        if (slots[i] == 0)
+        {
+            slots[i] = hash;
+            count++;
+            return true;
+        }
+    }
+}
+
+/**
+ * @param hash Fingerprint from canonicalHash
+ * @return True if the fingerprint is present
+ */
+bool PuzzleIndex::contains(uint64_t hash) const
+{
+    if (hash == 0) hash = 1;
+    size_t mask = slots.size() - 1;
+    for (size_t i = hash & mask; slots[i] != 0; i = (i + 1) & mask)
+    {
+        if (slots[i] == hash) return true;
+    }
+    return false;
+}
+
+/**
+ * Adds the equivalence class of a grid
+ * @param grid Digits, 0 for empty
+ * @return False if an equivalent grid was added before
+ */
+bool PuzzleIndex::insertPuzzle(const uint8_t grid[81])
+{
+    return insert(canonicalHash(grid));
+}
+
+/**
+ * @return Number of fingerprints in the index
+ */
+size_t PuzzleIndex::size() const
+{
+    return count;
+}
+
+/**
+ * Adds the fingerprints of an index file written by saveFile
+ * @param path Index file: native-endian 64-bit fingerprints
+ * @return Fingerprints read, -1 if the file cannot be opened
+ */
+long PuzzleIndex::loadFile(const char* path)
+{
+    FILE* in = fopen(path, "rb");
+    if (!in) return -1;
+    uint64_t hashes[512];
+    long read = 0;
+    size_t n;
+    while ((n = fread(hashes, sizeof(uint64_t), 512, in)) > 0)
+    {
+        for (size_t i = 0; i < n; i++)
+        {
+            insert(hashes[i]);
+        }
+        read += n;
+    }
+    fclose(in);
+    return read;
+}
+
+/**
+ * Writes every fingerprint to an index file
+ * @param path Index file, overwritten
+ * @return False if the file cannot be written
+ */
+bool PuzzleIndex::saveFile(const char* path) const
+{
+    FILE* out = fopen(path, "wb");
+    if (!out) return false;
+    bool ok = true;
+    for (uint64_t hash : slots)
+    {
+        if (hash) ok &= fwrite(&hash, sizeof(hash), 1, out) == 1;
+    }
+    return fclose(out) == 0 && ok;
+}
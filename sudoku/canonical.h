@@ -0,0 +1,40 @@
+#ifndef CANONICAL_H
+#define CANONICAL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Canonical form of a 9x9 grid (puzzle or solution) under the Sudoku
+// symmetries that keep it valid: transposition, band and stack order, row
+// order within a band, column order within a stack, and digit relabeling.
+// Two grids are equivalent exactly when their canonical forms are equal.
+// The form is the lexicographically smallest transformed grid (empty cells
+// as 0, digits relabeled 1, 2, 3... in reading order), found by a search
+// over column arrangements and row orders that prunes every prefix already
+// larger than the best one.
+void canonicalForm(const uint8_t grid[81], uint8_t canonical[81]);
+uint64_t canonicalHash(const uint8_t grid[81]);  // 64-bit fingerprint of the canonical form
+
+// Set of canonical fingerprints for rejecting equivalent puzzles in O(1):
+// open addressing with linear probing, kept at most half full. Fingerprint
+// 0 marks an empty slot, so a hash of 0 is stored as 1. The set can be kept
+// on disk between runs as a flat array of fingerprints.
+class PuzzleIndex {
+private:
+    std::vector<uint64_t> slots;
+    size_t count;
+
+    void grow();                                 // Doubles the table and reinserts
+
+public:
+    explicit PuzzleIndex(size_t expected = 1024);
+    bool insert(uint64_t hash);                  // Adds a fingerprint, false if already present
+    bool contains(uint64_t hash) const;
+    bool insertPuzzle(const uint8_t grid[81]);   // Adds a grid's class, false if an equivalent one is present
+    size_t size() const;                         // Number of fingerprints
+    long loadFile(const char* path);             // Adds fingerprints from an index file, -1 if unreadable
+    bool saveFile(const char* path) const;       // Writes every fingerprint to an index file
+};
+
+#endif
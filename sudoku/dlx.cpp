@@ -0,0 +1,288 @@
+#include "dlx.h"
+#include <cstring>
+
+/**
+ * DLXSolver constructor - Links the full exact-cover matrix once
+ */
+DLXSolver::DLXSolver()
+{
+    build();
+    givenCount = 0;
+    depth = 0;
+    solutionsFound = 0;
+    solutionLimit = 1;
+    memset(solution, 0, sizeof(solution));
+    ::resetStats(stats);
+}
+
+/**
+ * Builds the 729-row exact-cover matrix in the node pool
+ * Column headers occupy nodes 1..324, matrix nodes follow in row order
+ */
+void DLXSolver::build()
+{
+    for (int h = 0; h <= COLUMNS; h++)
+    {
+        left[h] = h - 1;
+        right[h] = h + 1;
+        up[h] = h;
+        down[h] = h;
+        column[h] = h;
+        rowId[h] = -1;
+        size[h] = 0;
+        covered[h] = false;
+    }
+    left[ROOT] = COLUMNS;
+    right[COLUMNS] = ROOT;
+
+    int node = COLUMNS + 1;
+    for (int row = 0; row < ROWS; row++)
+    {
+        int cell = row / 9;
+        int digit = row % 9;
+        int r = cell / 9;
+        int c = cell % 9;
+        int b = (r / 3) * 3 + c / 3;
+        int cols[4] = { cell, 81 + r * 9 + digit, 162 + c * 9 + digit, 243 + b * 9 + digit };
+
+        rowStart[row] = node;
+        for (int k = 0; k < 4; k++)
+        {
+            int h = cols[k] + 1;
+            column[node] = h;
+            rowId[node] = row;
+
+            // Append at the bottom of the column
+            up[node] = up[h];
+            down[node] = h;
+            down[up[h]] = node;
+            up[h] = node;
+            size[h]++;
+
+            // Link into the row ring
+            left[node] = (k == 0) ? node + 3 : node - 1;
+            right[node] = (k == 3) ? node - 3 : node + 1;
+            node++;
+        }
+    }
+}
+
+/**
+ * Removes a column and every row that intersects it
+ * @param col Column header node
+ */
+void DLXSolver::cover(int col)
+{
+    right[left[col]] = right[col];
+    left[right[col]] = left[col];
+    covered[col] = true;
+    for (int i = down[col]; i != col; i = down[i])
+    {
+        for (int j = right[i]; j != i; j = right[j])
+        {
+            down[up[j]] = down[j];
+            up[down[j]] = up[j];
+            size[column[j]]--;
+        }
+    }
+}
+
+/**
+ * Restores a column removed by cover, in exact reverse order
+ * @param col Column header node
+ */
+void DLXSolver::uncover(int col)
+{
+    for (int i = up[col]; i != col; i = up[i])
+    {
+        for (int j = left[i]; j != i; j = left[j])
+        {
+            size[column[j]]++;
+            down[up[j]] = j;
+            up[down[j]] = j;
+        }
+    }
+    covered[col] = false;
+    right[left[col]] = col;
+    left[right[col]] = col;
+}
+
+/**
+ * Commits to a matrix row by covering all four of its columns
+ * @param row Matrix row (cell * 9 + digit - 1)
+ */
+void DLXSolver::selectRow(int row)
+{
+    int start = rowStart[row];
+    int j = start;
+    do
+    {
+        cover(column[j]);
+        j = right[j];
+    } while (j != start);
+}
+
+/**
+ * Undoes selectRow
+ * @param row Matrix row previously selected
+ */
+void DLXSolver::deselectRow(int row)
+{
+    int start = left[rowStart[row]];
+    int j = start;
+    do
+    {
+        uncover(column[j]);
+        j = left[j];
+    } while (j != start);
+}
+
+/**
+ * Restores the matrix to its unconstrained state
+ */
+void DLXSolver::releaseGivens()
+{
+    while (givenCount > 0)
+    {
+        deselectRow(givenRows[--givenCount]);
+    }
+}
+
+/**
+ * Loads a puzzle by selecting the matrix row of every given
+ * @param puzzle Puzzle in row-major order with 0 for empty cells
+ * @return False if two givens conflict, true otherwise
+ */
+bool DLXSolver::load(const uint8_t puzzle[81])
+{
+    releaseGivens();
+    for (int cell = 0; cell < 81; cell++)
+    {
+        int num = puzzle[cell];
+        if (num == 0) continue;
+        if (num > 9)
+        {
+            return false;
+        }
+
+        // A given whose constraint is already satisfied conflicts with an earlier one
+        int row = cell * 9 + num - 1;
+        int start = rowStart[row];
+        int j = start;
+        do
+        {
+            if (covered[column[j]]) return false;
+            j = right[j];
+        } while (j != start);
+
+        selectRow(row);
+        givenRows[givenCount++] = row;
+    }
+    return true;
+}
+
+/**
+ * Algorithm X: branches on the column with the fewest remaining rows
+ * @return True once the solution limit is reached, false to keep searching
+ */
+bool DLXSolver::search()
+{
+    STATS_INC(stats, nodes);
+    if (right[ROOT] == ROOT)
+    {
+        if (solutionsFound == 0)
+        {
+            for (int i = 0; i < givenCount; i++)
+            {
+                solution[givenRows[i] / 9] = givenRows[i] % 9 + 1;
+            }
+            for (int i = 0; i < depth; i++)
+            {
+                solution[partial[i] / 9] = partial[i] % 9 + 1;
+            }
+        }
+        solutionsFound++;
+        return solutionsFound >= solutionLimit;
+    }
+
+    int best = right[ROOT];
+    for (int h = right[best]; h != ROOT && size[best] > 1; h = right[h])
+    {
+        if (size[h] < size[best]) best = h;
+    }
+    if (size[best] == 0) return false;
+
+    bool done = false;
+    cover(best);
+    for (int i = down[best]; i != best && !done; i = down[i])
+    {
+        partial[depth++] = rowId[i];
+        STATS_INC(stats, guesses);
+        for (int j = right[i]; j != i; j = right[j])
+        {
+            cover(column[j]);
+        }
+        STATS_ENTER(stats);
+        done = search();
+        STATS_LEAVE(stats);
+        for (int j = left[i]; j != i; j = left[j])
+        {
+            uncover(column[j]);
+        }
+        depth--;
+        if (!done) STATS_INC(stats, backtracks);
+    }
+    uncover(best);
+    return done;
+}
+
+/**
+ * Solves the loaded puzzle
+ * @return True if a solution was found, false if unsolvable
+ */
+bool DLXSolver::solve()
+{
+    return countSolutions(1) == 1;
+}
+
+/**
+ * Enumerates solutions of the loaded puzzle, stopping early at the limit
+ * The matrix is fully restored to the loaded state afterwards
+ * @param limit Maximum number of solutions to look for
+ * @return Number of solutions found (at most limit)
+ */
+int DLXSolver::countSolutions(int limit)
+{
+    STATS_TIMER(stats, PHASE_SOLVE);
+    solutionsFound = 0;
+    solutionLimit = limit;
+    depth = 0;
+    search();
+    return solutionsFound;
+}
+
+/**
+ * Copies the first solution found by the last solve or count
+ * @param out [out] Receives the solved grid in row-major order
+ */
+void DLXSolver::getSolution(uint8_t out[81]) const
+{
+    memcpy(out, solution, sizeof(solution));
+}
+
+/**
+ * @return Counters accumulated since the last resetStats (zero unless built
+ *         with SUDOKU_STATS)
+ */
+const SolverStats& DLXSolver::getStats() const
+{
+    return stats;
+}
+
+/**
+ * Zeroes the counters and phase timers
+ */
+void DLXSolver::resetStats()
+{
+    ::resetStats(stats);
+}
@@ -0,0 +1,51 @@
+#ifndef DLX_H
+#define DLX_H
+
+#include <cstdint>
+#include "stats.h"
+
+// Exact-cover solver using Knuth's Dancing Links (Algorithm X)
+// The whole 729x324 matrix lives in fixed arrays inside the object, so
+// building and searching never touches the heap
+class DLXSolver {
+private:
+    static const int COLUMNS = 324;              // 81 cells + 81 row-digit + 81 col-digit + 81 box-digit
+    static const int ROWS = 729;                 // One row per (cell, digit)
+    static const int NODES = 1 + COLUMNS + ROWS * 4;
+    static const int ROOT = 0;
+
+    int left[NODES], right[NODES], up[NODES], down[NODES];
+    int column[NODES];                           // Column header of each node
+    int rowId[NODES];                            // Matrix row of each node
+    int size[COLUMNS + 1];                       // Live nodes per column
+    int rowStart[ROWS];                          // First node of each matrix row
+    bool covered[COLUMNS + 1];
+
+    int givenRows[81];                           // Rows selected by the givens
+    int givenCount;
+    int partial[81];                             // Rows chosen by the search
+    int depth;
+    uint8_t solution[81];
+    int solutionsFound;
+    int solutionLimit;
+    SolverStats stats;
+
+    void build();                                // Links the full matrix
+    void cover(int col);
+    void uncover(int col);
+    void selectRow(int row);                     // Covers all columns of a row
+    void deselectRow(int row);
+    void releaseGivens();
+    bool search();
+
+public:
+    DLXSolver();
+    bool load(const uint8_t puzzle[81]);         // Loads givens, false on conflict
+    bool solve();                                // Finds one solution
+    int countSolutions(int limit);               // Counts solutions up to limit
+    void getSolution(uint8_t out[81]) const;     // Copies last found solution
+    const SolverStats& getStats() const;         // Counters since the last resetStats
+    void resetStats();                           // Zeroes the counters
+};
+
+#endif
@@ -0,0 +1,350 @@
+#include <iostream>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include <map>
+#include <thread>
+#include <vector>
+#include "generator.h"
+#include "grader.h"
+#include "thread_pool.h"
+#include "bounded_queue.h"
+#include "canonical.h"
+#include "grid.h"
+using namespace std;
+
+// Puzzles produced per pool task; large enough to amortize scheduling
+static const int CHUNK_SIZE = 64;
+
+// One output line: 81 digits, an optional grade and a newline
+struct PuzzleLine {
+    char text[96];
+    int length;
+    uint64_t hash;                  // canonicalHash of the puzzle, 0 unless deduplicating
+    long chunk;                     // Chunk that produced the line
+};
+
+// One worker's generator padded to whole cache lines, so workers writing
+// their RNG and solver scratch never share a line (no false sharing)
+template <typename Generator>
+struct alignas(64) WorkerGenerator {
+    Generator generator;
+};
+
+struct GenOptions {
+    long count = 10000;
+    int threads = 0;                // 0 = all cores
+    uint64_t seed = 1;
+    int holes = 0;                  // 0 = random 40-54 like the game
+    int restarts = 0;               // Greedy passes per minimal puzzle, 0 = not minimal
+    const char* output = nullptr;   // nullptr = stdout
+    bool scaling = false;
+    bool grade = false;             // Append the logical difficulty grade
+    bool unique = false;            // Drop puzzles equivalent to one already written
+    const char* index = nullptr;    // Index file of earlier runs' puzzles (implies unique)
+    Variant variant = VARIANT_CLASSIC; // Rule set the puzzles must be unique under
+};
+
+/**
+ * Generates one chunk of puzzles on a worker and hands them to the writer
+ * @param generator The worker's own generator (RNG and solver scratch):
+ *        PuzzleGenerator, or GridGenerator for a variant
+ * @param seed Chunk seed, so output does not depend on thread scheduling
+ * @param chunk Chunk index, for the writer's ordering
+ * @param count Puzzles in this chunk
+ * @param holes Target empty cells, 0 for random 40-54
+ * @param restarts Reduce to minimal puzzles with this many greedy passes,
+ *        0 to punch holes instead
+ * @param grade Append the grade from the logical solver to each line
+ * @param unique Fingerprint each puzzle for the writer's duplicate check
+ * @param queue Queue drained by the single writer
+ */
+template <typename Generator>
+static void generateChunk(Generator& generator, uint64_t seed, long chunk, int count, int holes, int restarts, bool grade,
+                          bool unique, BoundedQueue<PuzzleLine>& queue)
+{
+    generator.reseed(seed);
+    uint8_t solution[81];
+    uint8_t puzzle[81];
+    PuzzleLine line;
+    line.chunk = chunk;
+
+    for (int i = 0; i < count; i++)
+    {
+        generator.randomSolution(solution);
+        if (restarts > 0)
+        {
+            generator.minimalPuzzle(solution, puzzle, restarts);
+        }
+        else
+        {
+            int target = holes > 0 ? holes : 40 + generator.randomBelow(15);
+            generator.removeClues(solution, puzzle, target);
+        }
+        for (int cell = 0; cell < 81; cell++)
+        {
+            line.text[cell] = '0' + puzzle[cell];
+        }
+        line.length = 81;
+        if (grade)
+        {
+            const char* name = difficultyName(gradePuzzle(puzzle).difficulty);
+            line.text[line.length++] = ' ';
+            while (*name) line.text[line.length++] = *name++;
+        }
+        line.text[line.length++] = '\n';
+        line.hash = unique ? canonicalHash(puzzle) : 0;
+        while (!queue.tryPush(line))
+        {
+            this_thread::yield();  // Writer is behind
+        }
+    }
+}
+
+/**
+ * Generates puzzles across a work-stealing pool and streams them through
+ * a lock-free queue to the calling thread, which is the only writer.
+ * With an index the workers also canonicalize each puzzle and the writer
+ * drops every puzzle whose class is already in the index, submitting more
+ * chunks until the requested number of distinct puzzles is written. The
+ * writer then holds lines back and checks them in chunk order, with at
+ * most a window of chunks in flight, so which of two equivalent puzzles is
+ * kept depends on the seed only, not on which worker finished first.
+ * @param options Run configuration
+ * @param threads Number of worker threads
+ * @param out Destination, or nullptr to discard (scaling runs)
+ * @param index Classes already written, nullptr to keep duplicates
+ * @param duplicates [out] Puzzles dropped as duplicates, if not nullptr
+ * @return Elapsed seconds
+ */
+template <typename Generator>
+static double runGeneration(const GenOptions& options, int threads, FILE* out, PuzzleIndex* index = nullptr,
+                            long* duplicates = nullptr)
+{
+    BoundedQueue<PuzzleLine> queue(4096);
+    vector<WorkerGenerator<Generator> > generators(threads);  // Per-thread scratch
+    long dropped = 0;
+
+    auto start = chrono::steady_clock::now();
+    {
+        ThreadPool pool(threads);
+        bool ordered = index != nullptr;         // Deduplicate in chunk order
+        long window = 8L * threads;              // Chunks in flight past the next one to check (ordered)
+        long nextChunk = 0;
+        long checkedChunks = 0;                  // Chunks whose lines went through the index (ordered)
+        long submitted = 0;                      // Lines the submitted chunks will produce
+        long wanted = options.count;             // Lines to submit chunks for
+        vector<int> chunkSizes;                  // Lines per submitted chunk
+        auto submitChunks = [&]() {
+            while (submitted < wanted && (!ordered || nextChunk < checkedChunks + window))
+            {
+                int count = (int)min<long>(CHUNK_SIZE, wanted - submitted);
+                long chunk = nextChunk++;
+                uint64_t seed = options.seed + (uint64_t)chunk;
+                pool.submit([&generators, &queue, &options, seed, chunk, count, ordered](int worker) {
+                    generateChunk(generators[worker].generator, seed, chunk, count, options.holes, options.restarts,
+                                  options.grade, ordered, queue);
+                });
+                chunkSizes.push_back(count);
+                submitted += count;
+            }
+        };
+        submitChunks();
+
+        // Single writer: batch lines into a large buffer, one fwrite per fill.
+        // Every submitted line is popped, even past the count, so no worker
+        // is left waiting on a full queue.
+        static char buffer[1 << 20];
+        size_t used = 0;
+        long written = 0;
+        auto writeLine = [&](const PuzzleLine& line) {
+            if (written == options.count) return;  // Extra lines stay out of the index too
+            if (index && !index->insert(line.hash))
+            {
+                dropped++;
+                return;
+            }
+            written++;
+            if (!out) return;
+            if (used + line.length > sizeof(buffer))
+            {
+                fwrite(buffer, 1, used, out);
+                used = 0;
+            }
+            memcpy(buffer + used, line.text, line.length);
+            used += line.length;
+        };
+
+        map<long, vector<PuzzleLine> > held;     // Lines of chunks not yet checked, by chunk (ordered)
+        PuzzleLine line;
+        long received = 0;
+        while (written < options.count || received < submitted)
+        {
+            if (received == submitted)
+            {
+                wanted = submitted + (options.count - written);
+                submitChunks();
+            }
+            if (!queue.tryPop(line))
+            {
+                this_thread::yield();
+                continue;
+            }
+            received++;
+            if (!ordered)
+            {
+                writeLine(line);
+                continue;
+            }
+            held[line.chunk].push_back(line);
+            auto next = held.begin();
+            while (next != held.end() && next->first == checkedChunks && (int)next->second.size() == chunkSizes[checkedChunks])
+            {
+                for (const PuzzleLine& heldLine : next->second) writeLine(heldLine);
+                next = held.erase(next);
+                checkedChunks++;
+            }
+            submitChunks();
+        }
+        if (out && used > 0) fwrite(buffer, 1, used, out);
+    }
+    if (duplicates) *duplicates = dropped;
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * Runs runGeneration with the generator for the selected rule set; each
+ * variant gets its own compiled solver
+ * Same parameters and result as runGeneration
+ */
+static double runVariant(const GenOptions& options, int threads, FILE* out, PuzzleIndex* index = nullptr,
+                         long* duplicates = nullptr)
+{
+    switch (options.variant)
+    {
+        case VARIANT_DIAGONAL:   return runGeneration<GridGenerator<3, DiagonalRules> >(options, threads, out, index, duplicates);
+        case VARIANT_WINDOKU:    return runGeneration<GridGenerator<3, WindokuRules> >(options, threads, out, index, duplicates);
+        case VARIANT_ANTIKNIGHT: return runGeneration<GridGenerator<3, AntiKnightRules> >(options, threads, out, index, duplicates);
+        default:                 return runGeneration<PuzzleGenerator>(options, threads, out, index, duplicates);
+    }
+}
+
+/**
+ * Prints command-line usage
+ */
+static void printUsage()
+{
+    cerr << "Usage: sudoku-gen [-n COUNT] [-t THREADS] [-s SEED] [--holes N] [-o FILE] [--grade] [--scaling]\n"
+         << "                  [--unique] [--index FILE] [--minimal] [--restarts N] [--variant V]\n"
+         << "  -n COUNT     puzzles to generate (default 10000)\n"
+         << "  -t THREADS   worker threads (default: all cores)\n"
+         << "  -s SEED      base seed; same seed gives the same set of puzzles\n"
+         << "  --holes N    empty cells per puzzle (default: random 40-54)\n"
+         << "  --minimal    remove clues until every remaining clue is needed (usually 20-26 clues)\n"
+         << "  --restarts N greedy passes per minimal puzzle, keeping the fewest clues (implies --minimal)\n"
+         << "  --variant V  classic (default), diagonal, windoku or antiknight; puzzles are\n"
+         << "               unique under that variant's rules\n"
+         << "  -o FILE      write puzzles to FILE instead of stdout\n"
+         << "  --grade      append the logical difficulty grade (easy..evil) to each line\n"
+         << "  --scaling    report puzzles/sec for 1..THREADS threads, no output\n"
+         << "  --unique     write only puzzles not equivalent (by symmetry and relabeling)\n"
+         << "               to one already written, checked in seed order, so the same\n"
+         << "               seed keeps the same puzzles on any number of threads\n"
+         << "  --index FILE also skip puzzles recorded in FILE by earlier runs, and add\n"
+         << "               this run's puzzles to it (implies --unique)\n"
+         << "  --grade, --unique and --index are for classic puzzles only\n";
+}
+
+/**
+ * Bulk puzzle generator entry point
+ * Writes one 81-digit puzzle per line, 0 for empty cells
+ */
+int main(int argc, char* argv[])
+{
+    GenOptions options;
+    for (int i = 1; i < argc; i++)
+    {
+        bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "-n") == 0 && hasValue) options.count = atol(argv[++i]);
+        else if (strcmp(argv[i], "-t") == 0 && hasValue) options.threads = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-s") == 0 && hasValue) options.seed = strtoull(argv[++i], nullptr, 10);
+        else if (strcmp(argv[i], "--holes") == 0 && hasValue) options.holes = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--minimal") == 0) options.restarts = max(options.restarts, 1);
+        else if (strcmp(argv[i], "--restarts") == 0 && hasValue) options.restarts = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-o") == 0 && hasValue) options.output = argv[++i];
+        else if (strcmp(argv[i], "--grade") == 0) options.grade = true;
+        else if (strcmp(argv[i], "--scaling") == 0) options.scaling = true;
+        else if (strcmp(argv[i], "--unique") == 0) options.unique = true;
+        else if (strcmp(argv[i], "--index") == 0 && hasValue) options.index = argv[++i];
+        else if (strcmp(argv[i], "--variant") == 0 && hasValue && parseVariant(argv[i + 1], options.variant)) i++;
+        else
+        {
+            printUsage();
+            return 1;
+        }
+    }
+    if (options.threads <= 0) options.threads = max(1u, thread::hardware_concurrency());
+    bool classicOnly = options.grade || options.unique || options.index;
+    if (options.count <= 0 || options.holes < 0 || options.holes > 64 || options.restarts < 0 ||
+        (options.variant != VARIANT_CLASSIC && classicOnly))
+    {
+        printUsage();
+        return 1;
+    }
+
+    if (options.scaling)
+    {
+        double base = 0;
+        cout << "threads\tpuzzles/sec\tspeedup\n";
+        vector<int> counts;
+        for (int threads = 1; threads < options.threads; threads *= 2) counts.push_back(threads);
+        counts.push_back(options.threads);
+
+        for (int threads : counts)
+        {
+            double seconds = runVariant(options, threads, nullptr);
+            double rate = options.count / seconds;
+            if (threads == 1) base = rate;
+            cout << threads << "\t" << (long)rate << "\t" << (rate / base) << "x\n";
+        }
+        return 0;
+    }
+
+    FILE* out = stdout;
+    if (options.output)
+    {
+        out = fopen(options.output, "wb");
+        if (!out)
+        {
+            cerr << "Error: Could not open " << options.output << "\n";
+            return 1;
+        }
+    }
+
+    // Deduplication: the index starts from earlier runs' puzzles, if any
+    PuzzleIndex index(options.count);
+    long duplicates = 0;
+    if (options.index)
+    {
+        options.unique = true;
+        if (index.loadFile(options.index) < 0 && errno != ENOENT)
+        {
+            cerr << "Error: Could not read " << options.index << "\n";
+            return 1;
+        }
+    }
+
+    double seconds = runVariant(options, options.threads, out, options.unique ? &index : nullptr, &duplicates);
+    if (out != stdout) fclose(out);
+    cerr << options.count << " puzzles in " << seconds << " s (" << (long)(options.count / seconds)
+         << " puzzles/sec, " << options.threads << " threads)\n";
+    if (options.unique) cerr << duplicates << " duplicates dropped\n";
+    if (options.index && !index.saveFile(options.index))
+    {
+        cerr << "Error: Could not write " << options.index << "\n";
+        return 1;
+    }
+    return 0;
+}
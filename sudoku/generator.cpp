@@ -0,0 +1,82 @@
+#include "generator.h"
+#include <cstring>
+
+/**
+ * PuzzleGenerator constructor
+ * @param seed Seed for the generator's random engine
+ */
+PuzzleGenerator::PuzzleGenerator(uint64_t seed) : GridGenerator<3>(seed)
+{
+}
+
+/**
+ * Shuffles an array in place
+ * @param values Array to shuffle
+ * @param count Number of elements
+ */
+void PuzzleGenerator::shuffle(int* values, int count)
+{
+    for (int i = count - 1; i > 0; i--)
+    {
+        int j = randomBelow(i + 1);
+        int tmp = values[i];
+        values[i] = values[j];
+        values[j] = tmp;
+    }
+}
+
+/**
+ * Applies a random validity-preserving transform to a completed grid:
+ * digit relabeling, row and column permutations within bands and stacks,
+ * band and stack permutations, and optional transposition
+ * Much cheaper than a fresh random solve when many grids are needed
+ * @param grid [in/out] Completed grid to transform
+ */
+void PuzzleGenerator::shuffleSolution(uint8_t grid[81])
+{
+    int digits[10] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+    shuffle(digits + 1, 9);
+
+    int rows[9], cols[9];
+    int bands[3] = { 0, 1, 2 };
+    int stacks[3] = { 0, 1, 2 };
+    shuffle(bands, 3);
+    shuffle(stacks, 3);
+    for (int i = 0; i < 3; i++)
+    {
+        int inBand[3] = { 0, 1, 2 };
+        int inStack[3] = { 0, 1, 2 };
+        shuffle(inBand, 3);
+        shuffle(inStack, 3);
+        for (int j = 0; j < 3; j++)
+        {
+            rows[i * 3 + j] = bands[i] * 3 + inBand[j];
+            cols[i * 3 + j] = stacks[i] * 3 + inStack[j];
+        }
+    }
+    bool transpose = randomBelow(2) == 1;
+
+    uint8_t source[81];
+    memcpy(source, grid, sizeof(source));
+    for (int r = 0; r < 9; r++)
+    {
+        for (int c = 0; c < 9; c++)
+        {
+            int value = transpose ? source[cols[c] * 9 + rows[r]] : source[rows[r] * 9 + cols[c]];
+            grid[r * 9 + c] = digits[value];
+        }
+    }
+}
+
+/**
+ * Generates a game the way SudokuGame does: a random solution with 40-54
+ * cells emptied, so reseeding with the same seed reproduces the game
+ * @param solution [out] Completed grid
+ * @param puzzle [out] Puzzle with 0 for empty cells, unique solution
+ */
+void PuzzleGenerator::randomGame(uint8_t solution[81], uint8_t puzzle[81])
+{
+    randomSolution(solution);
+    int holes = 40 + randomBelow(15);
+    removeClues(solution, puzzle, holes);
+}
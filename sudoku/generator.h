@@ -0,0 +1,20 @@
+#ifndef GENERATOR_H
+#define GENERATOR_H
+
+#include "solver.h"
+#include "rng.h"
+
+// Builds 9x9 puzzles that are guaranteed to have exactly one solution: the
+// box-size-3 GridGenerator (grid.h) under the classic rules, plus the
+// game's puzzle recipe and symmetry shuffles that only apply to 9x9 grids
+class PuzzleGenerator : public GridGenerator<3> {
+private:
+    void shuffle(int* values, int count);        // Fisher-Yates shuffle
+
+public:
+    explicit PuzzleGenerator(uint64_t seed = 0);
+    void shuffleSolution(uint8_t grid[81]);      // Random symmetry transform of a grid
+    void randomGame(uint8_t solution[81], uint8_t puzzle[81]); // Solution and puzzle with 40-54 holes, like the game
+};
+
+#endif
@@ -0,0 +1,812 @@
+#include "grader.h"
+#include "board.h"
+#include "simd.h"
+#include <cstring>
+
+namespace {
+
+const uint16_t ALL_DIGITS = 0x1FF;
+
+// Cells of every unit (rows 0-8, columns 9-17, boxes 18-26) and the 20 peers
+// of every cell
+constexpr const SudokuTables& tables = sudokuTables;
+
+inline int popCount(uint32_t mask)
+{
+    return __builtin_popcount(mask);
+}
+
+inline int lowestDigit(uint16_t mask)
+{
+    return __builtin_ctz(mask) + 1;
+}
+
+}
+
+/**
+ * LogicalSolver constructor - Starts from an empty grid
+ */
+LogicalSolver::LogicalSolver()
+{
+    memset(cells, 0, sizeof(cells));
+    memset(cand, 0, sizeof(cand));
+    memset(counts, 0, sizeof(counts));
+    emptyCount = 81;
+}
+
+/**
+ * Loads a puzzle and computes every cell's candidates
+ * @param puzzle Puzzle in row-major order with 0 for empty cells
+ * @return False if a value is out of range or two givens conflict
+ */
+bool LogicalSolver::load(const uint8_t puzzle[81])
+{
+    Board board;
+    board.clear();
+    if (!board.load(puzzle)) return false;
+
+    memcpy(cells, puzzle, sizeof(cells));
+    memset(counts, 0, sizeof(counts));
+    emptyCount = 0;
+    for (int cell = 0; cell < 81; cell++)
+    {
+        cand[cell] = cells[cell] ? 0 : board.candidates(cell);
+        if (cells[cell] == 0) emptyCount++;
+    }
+    return true;
+}
+
+/**
+ * Places a digit and removes it from the candidates of all 20 peers
+ * @param cell Cell index (0-80)
+ * @param num Digit to place (1-9)
+ */
+void LogicalSolver::place(int cell, int num)
+{
+    uint16_t bit = 1 << (num - 1);
+    cells[cell] = num;
+    cand[cell] = 0;
+    emptyCount--;
+    for (int i = 0; i < 20; i++)
+    {
+        cand[tables.peers[cell][i]] &= ~bit;
+    }
+}
+
+/**
+ * @param cell Cell index (0-80)
+ * @param bits Candidates to remove
+ * @return True if any of the bits was still a candidate
+ */
+bool LogicalSolver::eliminate(int cell, uint16_t bits)
+{
+    if (!(cand[cell] & bits)) return false;
+    cand[cell] &= ~bits;
+    return true;
+}
+
+/**
+ * A digit with one remaining place in a unit goes there
+ */
+bool LogicalSolver::hiddenSingle(Deduction& step)
+{
+    for (int unit = 0; unit < 27; unit++)
+    {
+        const uint8_t* members = tables.units[unit];
+        uint16_t once = 0, twice = 0;
+        for (int i = 0; i < 9; i++)
+        {
+            uint16_t c = cand[members[i]];
+            twice |= once & c;
+            once |= c;
+        }
+        uint16_t hidden = once & ~twice;
+        if (!hidden) continue;
+
+        uint16_t bit = hidden & -hidden;
+        for (int i = 0; i < 9; i++)
+        {
+            if (cand[members[i]] & bit)
+            {
+                step.cell = members[i];
+                step.digit = lowestDigit(bit);
+                place(step.cell, step.digit);
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+/**
+ * A cell with one remaining candidate takes it
+ */
+bool LogicalSolver::nakedSingle(Deduction& step)
+{
+    for (int cell = 0; cell < 81; cell++)
+    {
+        uint16_t c = cand[cell];
+        if (c && !(c & (c - 1)))
+        {
+            step.cell = cell;
+            step.digit = lowestDigit(c);
+            place(cell, step.digit);
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Pointing: a digit confined to one line within a box is removed from the
+ * rest of that line. Claiming: a digit confined to one box within a line is
+ * removed from the rest of that box.
+ */
+bool LogicalSolver::lockedCandidates()
+{
+    bool changed = false;
+    for (int box = 0; box < 9; box++)
+    {
+        const uint8_t* members = tables.units[18 + box];
+        for (uint16_t bit = 1; bit <= 256; bit <<= 1)
+        {
+            int rows = 0, cols = 0, count = 0;
+            int firstCell = -1;
+            for (int i = 0; i < 9; i++)
+            {
+                if (!(cand[members[i]] & bit)) continue;
+                rows |= 1 << (i / 3);
+                cols |= 1 << (i % 3);
+                if (firstCell < 0) firstCell = members[i];
+                count++;
+            }
+            if (count < 2) continue;
+
+            int line = -1;
+            if (popCount(rows) == 1) line = Board::rowOf(firstCell);
+            else if (popCount(cols) == 1) line = 9 + Board::colOf(firstCell);
+            if (line < 0) continue;
+
+            for (int i = 0; i < 9; i++)
+            {
+                int cell = tables.units[line][i];
+                if (Board::boxOf(cell) != box) changed |= eliminate(cell, bit);
+            }
+            if (changed) return true;
+        }
+    }
+
+    for (int line = 0; line < 18; line++)
+    {
+        const uint8_t* members = tables.units[line];
+        for (uint16_t bit = 1; bit <= 256; bit <<= 1)
+        {
+            int boxes = 0, count = 0, box = 0;
+            for (int i = 0; i < 9; i++)
+            {
+                if (!(cand[members[i]] & bit)) continue;
+                box = Board::boxOf(members[i]);
+                boxes |= 1 << box;
+                count++;
+            }
+            if (count < 2 || popCount(boxes) != 1) continue;
+
+            for (int i = 0; i < 9; i++)
+            {
+                int cell = tables.units[18 + box][i];
+                bool onLine = line < 9 ? Board::rowOf(cell) == line : Board::colOf(cell) == line - 9;
+                if (!onLine) changed |= eliminate(cell, bit);
+            }
+            if (changed) return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * N cells of a unit whose candidates together are exactly N digits: those
+ * digits can be removed from the unit's other cells
+ * @param size Subset size (2 = pair, 3 = triple)
+ */
+bool LogicalSolver::nakedSubset(int size)
+{
+    for (int unit = 0; unit < 27; unit++)
+    {
+        const uint8_t* members = tables.units[unit];
+        int empty[9];
+        int n = 0;
+        for (int i = 0; i < 9; i++)
+        {
+            if (cand[members[i]]) empty[n++] = members[i];
+        }
+        if (n <= size) continue;
+
+        for (int pick = 1; pick < (1 << n); pick++)
+        {
+            if (popCount(pick) != size) continue;
+            uint16_t digits = 0;
+            for (int i = 0; i < n; i++)
+            {
+                if (pick & (1 << i)) digits |= cand[empty[i]];
+            }
+            if (popCount(digits) != size) continue;
+
+            bool changed = false;
+            for (int i = 0; i < n; i++)
+            {
+                if (!(pick & (1 << i))) changed |= eliminate(empty[i], digits);
+            }
+            if (changed) return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * N digits of a unit that fit in exactly N cells: those cells can hold no
+ * other digit
+ * @param size Subset size (2 = pair, 3 = triple)
+ */
+bool LogicalSolver::hiddenSubset(int size)
+{
+    for (int unit = 0; unit < 27; unit++)
+    {
+        const uint8_t* members = tables.units[unit];
+        uint16_t where[9];                       // Positions (bit i = member i) of each digit
+        uint16_t open = 0;
+        for (int d = 0; d < 9; d++)
+        {
+            where[d] = 0;
+            for (int i = 0; i < 9; i++)
+            {
+                if (cand[members[i]] & (1 << d)) where[d] |= 1 << i;
+            }
+            if (where[d]) open |= 1 << d;
+        }
+        if (popCount(open) <= size) continue;
+
+        for (int pick = 1; pick < 512; pick++)
+        {
+            if ((pick & ~open) || popCount(pick) != size) continue;
+            uint16_t positions = 0;
+            for (int d = 0; d < 9; d++)
+            {
+                if (pick & (1 << d)) positions |= where[d];
+            }
+            if (popCount(positions) != size) continue;
+
+            bool changed = false;
+            for (int i = 0; i < 9; i++)
+            {
+                if (positions & (1 << i)) changed |= eliminate(members[i], ALL_DIGITS & ~pick);
+            }
+            if (changed) return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Basic fish: if a digit's places in N rows lie in exactly N columns, it can
+ * be removed from those columns in every other row (and the same with rows
+ * and columns swapped)
+ * @param size Fish size (2 = X-Wing, 3 = Swordfish)
+ */
+bool LogicalSolver::fish(int size)
+{
+    for (int d = 0; d < 9; d++)
+    {
+        uint16_t bit = 1 << d;
+        for (int orientation = 0; orientation < 2; orientation++)
+        {
+            // lines[i] = positions of d across line i (rows, or columns when transposed)
+            uint16_t lines[9];
+            uint16_t baseLines = 0;
+            for (int i = 0; i < 9; i++)
+            {
+                lines[i] = 0;
+                for (int j = 0; j < 9; j++)
+                {
+                    int cell = orientation == 0 ? i * 9 + j : j * 9 + i;
+                    if (cand[cell] & bit) lines[i] |= 1 << j;
+                }
+                int count = popCount(lines[i]);
+                if (count >= 2 && count <= size) baseLines |= 1 << i;
+            }
+            if (popCount(baseLines) < size) continue;
+
+            for (int pick = 1; pick < 512; pick++)
+            {
+                if ((pick & ~baseLines) || popCount(pick) != size) continue;
+                uint16_t cover = 0;
+                for (int i = 0; i < 9; i++)
+                {
+                    if (pick & (1 << i)) cover |= lines[i];
+                }
+                if (popCount(cover) != size) continue;
+
+                bool changed = false;
+                for (int i = 0; i < 9; i++)
+                {
+                    if (pick & (1 << i)) continue;
+                    for (int j = 0; j < 9; j++)
+                    {
+                        if (!(cover & (1 << j))) continue;
+                        int cell = orientation == 0 ? i * 9 + j : j * 9 + i;
+                        changed |= eliminate(cell, bit);
+                    }
+                }
+                if (changed) return true;
+            }
+        }
+    }
+    return false;
+}
+
+/**
+ * XY-Wing: a pivot {a,b} sees pincers {a,c} and {b,c}; whichever value the
+ * pivot takes, one pincer is c, so c goes from cells seeing both pincers
+ */
+bool LogicalSolver::xyWing()
+{
+    for (int pivot = 0; pivot < 81; pivot++)
+    {
+        uint16_t ab = cand[pivot];
+        if (popCount(ab) != 2) continue;
+
+        for (int i = 0; i < 20; i++)
+        {
+            int first = tables.peers[pivot][i];
+            uint16_t ac = cand[first];
+            if (popCount(ac) != 2 || popCount(ac & ab) != 1) continue;
+            uint16_t c = ac & ~ab;
+
+            for (int j = 0; j < 20; j++)
+            {
+                int second = tables.peers[pivot][j];
+                uint16_t bc = cand[second];
+                if (second == first || bc != ((ab & ~ac) | c)) continue;
+
+                bool changed = false;
+                for (int k = 0; k < 20; k++)
+                {
+                    int target = tables.peers[first][k];
+                    if (target != second && target != pivot && sharesUnit(target, second))
+                    {
+                        changed |= eliminate(target, c);
+                    }
+                }
+                if (changed) return true;
+            }
+        }
+    }
+    return false;
+}
+
+/**
+ * Simple colouring: conjugate pairs of a digit (units where it has exactly
+ * two places) form chains whose cells alternate true/false. Two cells of one
+ * colour in a unit make that colour false (wrap); a cell seeing both
+ * colours cannot hold the digit (trap).
+ */
+bool LogicalSolver::simpleColoring()
+{
+    for (int d = 0; d < 9; d++)
+    {
+        uint16_t bit = 1 << d;
+
+        // Conjugate links per cell
+        uint8_t links[81][27];
+        uint8_t linkCount[81] = {};
+        for (int unit = 0; unit < 27; unit++)
+        {
+            int ends[2];
+            int n = 0;
+            for (int i = 0; i < 9 && n <= 2; i++)
+            {
+                if (cand[tables.units[unit][i]] & bit)
+                {
+                    if (n < 2) ends[n] = tables.units[unit][i];
+                    n++;
+                }
+            }
+            if (n != 2) continue;
+            links[ends[0]][linkCount[ends[0]]++] = ends[1];
+            links[ends[1]][linkCount[ends[1]]++] = ends[0];
+        }
+
+        int8_t color[81];
+        memset(color, -1, sizeof(color));
+        for (int start = 0; start < 81; start++)
+        {
+            if (linkCount[start] == 0 || color[start] >= 0) continue;
+
+            // Two-colour one chain
+            int chain[81];
+            int size = 0;
+            color[start] = 0;
+            chain[size++] = start;
+            for (int head = 0; head < size; head++)
+            {
+                int cell = chain[head];
+                for (int k = 0; k < linkCount[cell]; k++)
+                {
+                    int next = links[cell][k];
+                    if (color[next] < 0)
+                    {
+                        color[next] = 1 - color[cell];
+                        chain[size++] = next;
+                    }
+                }
+            }
+            if (size < 3) continue;
+
+            // Colour wrap
+            for (int i = 0; i < size; i++)
+            {
+                for (int j = i + 1; j < size; j++)
+                {
+                    if (color[chain[i]] != color[chain[j]] || !sharesUnit(chain[i], chain[j])) continue;
+                    int wrong = color[chain[i]];
+                    for (int k = 0; k < size; k++)
+                    {
+                        if (color[chain[k]] == wrong) eliminate(chain[k], bit);
+                    }
+                    return true;
+                }
+            }
+
+            // Colour trap
+            bool changed = false;
+            for (int cell = 0; cell < 81; cell++)
+            {
+                if (!(cand[cell] & bit) || color[cell] >= 0) continue;
+                bool seesColor[2] = { false, false };
+                for (int k = 0; k < size; k++)
+                {
+                    if (sharesUnit(cell, chain[k])) seesColor[color[chain[k]]] = true;
+                }
+                if (seesColor[0] && seesColor[1]) changed |= eliminate(cell, bit);
+            }
+            if (changed) return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Applies the cheapest technique that makes progress
+ * @param deduction [out] Technique used; cell and digit for placements,
+ *                  cell = -1 for eliminations
+ * @return False if no technique applies (solved or stuck)
+ */
+bool LogicalSolver::step(Deduction& deduction)
+{
+    deduction.cell = -1;
+    deduction.digit = 0;
+    if (emptyCount == 0) return false;
+
+    bool progress = false;
+    if (hiddenSingle(deduction)) deduction.technique = TECH_HIDDEN_SINGLE, progress = true;
+    else if (nakedSingle(deduction)) deduction.technique = TECH_NAKED_SINGLE, progress = true;
+    else if (lockedCandidates()) deduction.technique = TECH_LOCKED_CANDIDATES, progress = true;
+    else if (nakedSubset(2)) deduction.technique = TECH_NAKED_PAIR, progress = true;
+    else if (hiddenSubset(2)) deduction.technique = TECH_HIDDEN_PAIR, progress = true;
+    else if (nakedSubset(3)) deduction.technique = TECH_NAKED_TRIPLE, progress = true;
+    else if (hiddenSubset(3)) deduction.technique = TECH_HIDDEN_TRIPLE, progress = true;
+    else if (fish(2)) deduction.technique = TECH_X_WING, progress = true;
+    else if (fish(3)) deduction.technique = TECH_SWORDFISH, progress = true;
+    else if (xyWing()) deduction.technique = TECH_XY_WING, progress = true;
+    else if (simpleColoring()) deduction.technique = TECH_SIMPLE_COLORING, progress = true;
+
+    if (progress) counts[deduction.technique]++;
+    return progress;
+}
+
+/**
+ * Runs logical steps until the puzzle is solved or no technique applies
+ * @return Grade, techniques used and whether logic alone solved it
+ */
+GradeResult LogicalSolver::solve()
+{
+    GradeResult result;
+    result.steps = 0;
+    Deduction deduction;
+    while (step(deduction))
+    {
+        result.steps++;
+    }
+
+    result.solved = isSolved();
+    result.techniquesUsed = 0;
+    result.difficulty = GRADE_EASY;
+    for (int t = 0; t < TECH_COUNT; t++)
+    {
+        if (counts[t] == 0) continue;
+        result.techniquesUsed |= 1u << t;
+        Difficulty level = techniqueDifficulty((Technique)t);
+        if (level > result.difficulty) result.difficulty = level;
+    }
+    if (!result.solved) result.difficulty = GRADE_EVIL;
+    return result;
+}
+
+/**
+ * @return True if every cell is filled
+ */
+bool LogicalSolver::isSolved() const
+{
+    return emptyCount == 0;
+}
+
+/**
+ * @param cell Cell index (0-80)
+ * @return Digit in the cell, 0 if empty
+ */
+int LogicalSolver::getCell(int cell) const
+{
+    return cells[cell];
+}
+
+/**
+ * @param cell Cell index (0-80)
+ * @return Remaining candidate mask, 0 for filled cells
+ */
+uint16_t LogicalSolver::getCandidates(int cell) const
+{
+    return cand[cell];
+}
+
+/**
+ * HintEngine constructor - Starts from an empty grid
+ */
+HintEngine::HintEngine()
+{
+    uint8_t empty[81] = {};
+    load(empty);
+}
+
+/**
+ * Rebuilds candidates, per-unit digit counts and the single bitsets
+ * @param values Digits in row-major order, 0 for empty
+ */
+void HintEngine::load(const uint8_t values[81])
+{
+    computeCandidates(values, cand);
+
+    memcpy(cells, values, sizeof(cells));
+    memset(places, 0, sizeof(places));
+    memset(nakedSingles, 0, sizeof(nakedSingles));
+    memset(hiddenSingles, 0, sizeof(hiddenSingles));
+    for (int cell = 0; cell < 81; cell++)
+    {
+        if (popCount(cand[cell]) == 1) nakedSingles[cell >> 6] |= 1ULL << (cell & 63);
+    }
+    for (int unit = 0; unit < 27; unit++)
+    {
+        for (int i = 0; i < 9; i++)
+        {
+            for (uint16_t bits = cand[tables.units[unit][i]]; bits; bits &= bits - 1)
+            {
+                places[unit][__builtin_ctz(bits)]++;
+            }
+        }
+        for (int d = 0; d < 9; d++)
+        {
+            int key = unit * 9 + d;
+            if (places[unit][d] == 1) hiddenSingles[key >> 6] |= 1ULL << (key & 63);
+        }
+    }
+}
+
+/**
+ * Removes candidates from one cell and keeps the counts and bitsets in step
+ * @param cell Cell index (0-80)
+ * @param bits Candidates to remove
+ */
+void HintEngine::removeCandidates(int cell, uint16_t bits)
+{
+    bits &= cand[cell];
+    if (!bits) return;
+    cand[cell] &= ~bits;
+
+    const int units[3] = { Board::rowOf(cell), 9 + Board::colOf(cell), 18 + Board::boxOf(cell) };
+    for (; bits; bits &= bits - 1)
+    {
+        int d = __builtin_ctz(bits);
+        for (int k = 0; k < 3; k++)
+        {
+            int key = units[k] * 9 + d;
+            int left = --places[units[k]][d];
+            if (left == 1) hiddenSingles[key >> 6] |= 1ULL << (key & 63);
+            else if (left == 0) hiddenSingles[key >> 6] &= ~(1ULL << (key & 63));
+        }
+    }
+
+    uint64_t cellBit = 1ULL << (cell & 63);
+    if (popCount(cand[cell]) == 1) nakedSingles[cell >> 6] |= cellBit;
+    else nakedSingles[cell >> 6] &= ~cellBit;
+}
+
+/**
+ * Applies a placement: clears the cell and drops the digit from its 20 peers
+ * Overwrites or digits that are not candidates fall back to a full rebuild
+ * @param cell Cell index (0-80)
+ * @param num Digit placed (1-9)
+ */
+void HintEngine::place(int cell, int num)
+{
+    uint16_t bit = 1 << (num - 1);
+    if (cells[cell] != 0 || !(cand[cell] & bit))
+    {
+        uint8_t values[81];
+        memcpy(values, cells, sizeof(values));
+        values[cell] = num;
+        load(values);
+        return;
+    }
+
+    cells[cell] = num;
+    removeCandidates(cell, cand[cell]);
+    for (int i = 0; i < 20; i++)
+    {
+        removeCandidates(tables.peers[cell][i], bit);
+    }
+}
+
+/**
+ * Finds the next cell that can be filled by logic
+ * Singles come straight from the bitsets; only when none is left does the
+ * full technique ladder run on a copy of the grid
+ * @param hint [out] Cell, digit and justifying technique
+ * @return False if the grid is full or logic alone is stuck
+ */
+bool HintEngine::nextHint(Hint& hint) const
+{
+    for (int w = 0; w < 4; w++)
+    {
+        if (!hiddenSingles[w]) continue;
+        int key = w * 64 + __builtin_ctzll(hiddenSingles[w]);
+        uint16_t bit = 1 << (key % 9);
+        const uint8_t* members = tables.units[key / 9];
+        for (int i = 0; i < 9; i++)
+        {
+            if (cand[members[i]] & bit)
+            {
+                hint.cell = members[i];
+                hint.digit = key % 9 + 1;
+                hint.technique = TECH_HIDDEN_SINGLE;
+                return true;
+            }
+        }
+    }
+    for (int w = 0; w < 2; w++)
+    {
+        if (!nakedSingles[w]) continue;
+        hint.cell = w * 64 + __builtin_ctzll(nakedSingles[w]);
+        hint.digit = lowestDigit(cand[hint.cell]);
+        hint.technique = TECH_NAKED_SINGLE;
+        return true;
+    }
+    return logicalHint(hint);
+}
+
+/**
+ * Steps a LogicalSolver from the current grid until it places a digit
+ * @param hint [out] First placement and the hardest technique needed for it
+ * @return False if logic gets stuck before any placement
+ */
+bool HintEngine::logicalHint(Hint& hint) const
+{
+    LogicalSolver solver;
+    if (!solver.load(cells)) return false;
+
+    Deduction deduction;
+    Technique hardest = TECH_HIDDEN_SINGLE;
+    while (solver.step(deduction))
+    {
+        if (deduction.technique > hardest) hardest = deduction.technique;
+        if (deduction.cell >= 0)
+        {
+            hint.cell = deduction.cell;
+            hint.digit = deduction.digit;
+            hint.technique = hardest;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @param cell Cell index (0-80)
+ * @return Remaining candidate mask, 0 for filled cells
+ */
+uint16_t HintEngine::getCandidates(int cell) const
+{
+    return cand[cell];
+}
+
+/**
+ * Grades a puzzle by solving it with human techniques only
+ * @param puzzle Puzzle in row-major order with 0 for empty cells
+ * @return Grade result; GRADE_EVIL if the givens conflict or logic gets stuck
+ */
+GradeResult gradePuzzle(const uint8_t puzzle[81])
+{
+    LogicalSolver solver;
+    if (!solver.load(puzzle))
+    {
+        GradeResult invalid = { GRADE_EVIL, 0, 0, false };
+        return invalid;
+    }
+    return solver.solve();
+}
+
+/**
+ * @param technique Technique to rate
+ * @return Grade a puzzle gets if it needs this technique
+ */
+Difficulty techniqueDifficulty(Technique technique)
+{
+    switch (technique)
+    {
+        case TECH_HIDDEN_SINGLE:
+        case TECH_NAKED_SINGLE:      return GRADE_EASY;
+        case TECH_LOCKED_CANDIDATES:
+        case TECH_NAKED_PAIR:
+        case TECH_HIDDEN_PAIR:       return GRADE_MEDIUM;
+        case TECH_NAKED_TRIPLE:
+        case TECH_HIDDEN_TRIPLE:
+        case TECH_X_WING:            return GRADE_HARD;
+        default:                     return GRADE_EXPERT;
+    }
+}
+
+/**
+ * @param technique Technique to name
+ * @return Human-readable name
+ */
+const char* techniqueName(Technique technique)
+{
+    static const char* names[TECH_COUNT] = {
+        "Hidden Single", "Naked Single", "Locked Candidates", "Naked Pair", "Hidden Pair",
+        "Naked Triple", "Hidden Triple", "X-Wing", "Swordfish", "XY-Wing", "Simple Coloring"
+    };
+    return technique < TECH_COUNT ? names[technique] : "Unknown";
+}
+
+/**
+ * @param difficulty Grade to name
+ * @return Human-readable name
+ */
+const char* difficultyName(Difficulty difficulty)
+{
+    switch (difficulty)
+    {
+        case GRADE_EASY:   return "easy";
+        case GRADE_MEDIUM: return "medium";
+        case GRADE_HARD:   return "hard";
+        case GRADE_EXPERT: return "expert";
+        case GRADE_EVIL:   return "evil";
+    }
+    return "unknown";
+}
+
+/**
+ * Looks up a grade by the name difficultyName gives it
+ * @param name Grade name ("easy" ... "evil")
+ * @param difficulty [out] Matching grade
+ * @return False if the name is unknown
+ */
+bool parseDifficulty(const char* name, Difficulty& difficulty)
+{
+    for (int d = 0; d < DIFFICULTY_COUNT; d++)
+    {
+        if (strcmp(name, difficultyName((Difficulty)d)) == 0)
+        {
+            difficulty = (Difficulty)d;
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,116 @@
+#ifndef GRADER_H
+#define GRADER_H
+
+#include <cstdint>
+
+// Human solving techniques, in the order the logical solver tries them
+// (cheapest first)
+enum Technique {
+    TECH_HIDDEN_SINGLE,
+    TECH_NAKED_SINGLE,
+    TECH_LOCKED_CANDIDATES,
+    TECH_NAKED_PAIR,
+    TECH_HIDDEN_PAIR,
+    TECH_NAKED_TRIPLE,
+    TECH_HIDDEN_TRIPLE,
+    TECH_X_WING,
+    TECH_SWORDFISH,
+    TECH_XY_WING,
+    TECH_SIMPLE_COLORING,
+    TECH_COUNT
+};
+
+// Difficulty grade, set by the hardest technique a puzzle needs
+enum Difficulty {
+    GRADE_EASY,                                  // Singles only
+    GRADE_MEDIUM,                                // Locked candidates and pairs
+    GRADE_HARD,                                  // Triples and X-Wing
+    GRADE_EXPERT,                                // Swordfish and chains
+    GRADE_EVIL                                   // Needs guessing beyond these techniques
+};
+
+const int DIFFICULTY_COUNT = GRADE_EVIL + 1;
+
+// One logical step: a placement (cell >= 0) or a set of eliminations (cell = -1)
+struct Deduction {
+    Technique technique;
+    int cell;
+    int digit;
+};
+
+// Outcome of grading a puzzle
+struct GradeResult {
+    Difficulty difficulty;
+    uint32_t techniquesUsed;                     // Bit t set if Technique t was needed
+    int steps;                                   // Logical steps taken
+    bool solved;                                 // False if logic alone got stuck
+};
+
+// Solves like a human: applies the cheapest technique that makes progress,
+// then starts over from the cheapest again. Candidates are kept as one
+// 9-bit mask per cell and updated through the peer table on each placement.
+class LogicalSolver {
+private:
+    uint8_t cells[81];                           // Digits, 0 for empty
+    uint16_t cand[81];                           // Candidate mask per empty cell
+    int emptyCount;
+    int counts[TECH_COUNT];                      // Steps taken per technique
+
+    void place(int cell, int num);               // Sets digit and clears it from peers
+    bool eliminate(int cell, uint16_t bits);     // Removes candidates, true if any were present
+    bool hiddenSingle(Deduction& step);
+    bool nakedSingle(Deduction& step);
+    bool lockedCandidates();
+    bool nakedSubset(int size);
+    bool hiddenSubset(int size);
+    bool fish(int size);
+    bool xyWing();
+    bool simpleColoring();
+
+public:
+    LogicalSolver();
+    bool load(const uint8_t puzzle[81]);         // Loads puzzle, false on conflict
+    bool step(Deduction& deduction);             // Applies one technique, false if stuck
+    GradeResult solve();                         // Runs steps until solved or stuck
+    bool isSolved() const;                       // True if every cell is filled
+    int getCell(int cell) const;                 // Digit in cell, 0 if empty
+    uint16_t getCandidates(int cell) const;      // Remaining candidates of a cell
+};
+
+// Next cell a player could fill by logic, and the technique that proves it
+struct Hint {
+    int cell;
+    int digit;
+    Technique technique;                         // Hardest technique on the way to the placement
+};
+
+// Candidate grid kept up to date move by move for hints. A placement
+// touches only the cell and its 20 peers; cells with one candidate and
+// (unit, digit) pairs with one place are kept in bitsets, so finding a
+// single is a few word scans instead of a board rescan.
+class HintEngine {
+private:
+    uint8_t cells[81];                           // Digits, 0 for empty
+    uint16_t cand[81];                           // Candidate mask per empty cell
+    uint8_t places[27][9];                       // Candidate cells per (unit, digit)
+    uint64_t nakedSingles[2];                    // Bit cell: cell has one candidate
+    uint64_t hiddenSingles[4];                   // Bit unit*9+digit: digit has one place in unit
+
+    void removeCandidates(int cell, uint16_t bits); // Clears bits and updates counts and bitsets
+    bool logicalHint(Hint& hint) const;          // Runs the full technique ladder on a copy
+
+public:
+    HintEngine();
+    void load(const uint8_t values[81]);         // Rebuilds everything from a grid
+    void place(int cell, int num);               // Applies one move with O(20) updates
+    bool nextHint(Hint& hint) const;             // Next deducible cell, false if logic is stuck
+    uint16_t getCandidates(int cell) const;      // Candidates of an empty cell
+};
+
+GradeResult gradePuzzle(const uint8_t puzzle[81]);    // Grades a puzzle with a fresh solver
+Difficulty techniqueDifficulty(Technique technique);  // Grade a technique implies
+const char* techniqueName(Technique technique);       // Human-readable technique name
+const char* difficultyName(Difficulty difficulty);    // Human-readable grade name
+bool parseDifficulty(const char* name, Difficulty& difficulty); // Inverse of difficultyName
+
+#endif
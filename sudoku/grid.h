@@ -0,0 +1,856 @@
+#ifndef GRID_H
+#define GRID_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include "tables.h"
+#include "rules.h"
+#include "rng.h"
+#include "stats.h"
+
+// Boards of any box size: BOX = 2 (4x4), 3 (9x9), 4 (16x16) or 5 (25x25),
+// under any rule set of rules.h (classic by default; 9x9 variants add
+// units or peers). Sizes, mask and index types and the unit/peer tables
+// (tables.h, rules.h) are all fixed at compile time, so every loop bound is
+// a constant the compiler can unroll.
+// The 9x9 solver and generator are the BOX = 3 instances (SudokuSolver in
+// solver.h, PuzzleGenerator in generator.h); the game's Board (board.h)
+// adds fixed cells and a vectorized load on top of the same masks.
+
+// Digits and used-digit masks per unit
+template <int BOX, typename Rules = ClassicRules<BOX> >
+struct GridBoard {
+    static_assert(Rules::BOX == BOX, "Rule set is for another box size");
+    typedef GridTraits<BOX> T;
+    typedef RuleTablesOf<Rules> R;
+    typedef typename T::Mask Mask;
+
+    Mask unitMask[R::UNITS];                     // Rows, columns, boxes, then extra units
+    uint8_t cells[T::CELLS + 1];                 // Digits in row-major order, 0 for empty; the
+                                                 // last cell stays empty (peer padding)
+
+    void clear();                                // Empties every cell
+    bool load(const uint8_t values[]);           // Replaces all digits, false on conflict or range
+    void set(int cell, int num);                 // Places digit in an empty cell
+    void erase(int cell);                        // Empties a cell
+    Mask candidates(int cell) const;             // Digits not used by the cell's units or peers
+    bool canPlace(int cell, int num) const;      // Checks num against the cell's units and peers
+};
+
+// Shared by the solvers working on subtrees of one parallel search: every
+// solution found anywhere is counted in found, and stop is raised once it
+// reaches limit, which makes every solver unwind at its next node
+struct SearchControl {
+    std::atomic<bool> stop;
+    std::atomic<long> found;
+    long limit;
+};
+
+// Outcome of propagating a loaded puzzle without searching (GridSolver::split)
+enum SplitResult {
+    SPLIT_CONFLICT,                              // No solution
+    SPLIT_SOLVED,                                // Propagation alone solved it
+    SPLIT_BRANCH                                 // Needs a guess in the returned cell
+};
+
+// Bitmask solver for any box size and rule set: naked and hidden singles,
+// then a most-constrained-cell search, like SudokuSolver
+template <int BOX, typename Rules = ClassicRules<BOX> >
+class GridSolver {
+public:
+    typedef GridTraits<BOX> T;
+    typedef RuleTablesOf<Rules> R;
+    typedef typename T::Mask Mask;
+
+private:
+    GridBoard<BOX, Rules> board;
+    uint8_t solution[T::CELLS];                  // First solution found by the last search
+    typename T::Index trail[T::CELLS];           // Cells placed during search, for undo
+    int trailSize;
+    int emptyCount;
+    int solutionsFound;
+    int solutionLimit;
+    Xoshiro256* rng;                             // Shuffles branch order when set
+    SearchControl* control;                      // Shared count and cancellation, nullptr if searching alone
+    SolverStats stats;
+
+    void place(int cell, int num);
+    void undo(int mark);
+    bool propagate();
+    int branchCell() const;                      // Most constrained empty cell
+    bool search();
+
+public:
+    GridSolver();
+    bool load(const uint8_t puzzle[]);           // Loads T::CELLS givens, false on conflict
+    bool solve();                                // Finds one solution
+    bool solveRandom(Xoshiro256& random);        // Finds one solution, trying digits in random order
+    int countSolutions(int limit);               // Counts solutions up to limit
+    void getSolution(uint8_t out[]) const;       // Copies last found solution
+    bool setGiven(int cell, int num);            // Adds a given to the loaded puzzle
+    void clearGiven(int cell);                   // Removes a given from the loaded puzzle
+    int getGiven(int cell) const;                // Digit of a given, 0 if empty
+    SplitResult split(uint8_t cells[], int& cell, Mask& digits); // Propagates only, for splitting a search
+    void setControl(SearchControl* shared);      // Joins a parallel search, nullptr to leave it
+    const SolverStats& getStats() const;         // Counters since the last resetStats
+    void resetStats();                           // Zeroes the counters
+};
+
+// Puzzle generator for any box size and rule set: a random solve of the
+// empty grid, then clues removed in random order as long as the puzzle
+// stays unique. One solver instance is kept loaded with the current puzzle
+// and edited in place as clues are removed, so no removal pays for a full
+// reload. All randomness comes from the generator's own seeded engine, so
+// a given seed always reproduces the same puzzles and instances never
+// contend.
+template <int BOX, typename Rules = ClassicRules<BOX> >
+class GridGenerator {
+public:
+    typedef GridTraits<BOX> T;
+
+private:
+    GridSolver<BOX, Rules> solver;
+    Xoshiro256 rng;
+
+    bool clueNeeded(int cell, int num);          // True if removing the clue loses uniqueness
+
+public:
+    explicit GridGenerator(uint64_t seed = 0);
+    void reseed(uint64_t seed);                  // Restarts the random sequence
+    const Xoshiro256& getEngine() const;         // Random engine state, to resume the sequence later
+    void setEngine(const Xoshiro256& engine);    // Resumes a sequence saved with getEngine
+    void randomSolution(uint8_t grid[]);         // Random completed grid
+    int removeClues(const uint8_t solution[], uint8_t puzzle[], int holes); // Unique puzzle with up to holes empty cells
+    int minimalPuzzle(const uint8_t solution[], uint8_t puzzle[], int restarts = 1); // Puzzle where every clue is needed
+    uint32_t randomBelow(uint32_t bound);        // Draws from the generator's engine
+    const SolverStats& getStats() const;         // Solver counters since the last resetStats
+    void resetStats();                           // Zeroes the solver counters
+};
+
+template <int BOX, typename Rules = ClassicRules<BOX> >
+bool isSolvedGridOf(const uint8_t cells[]);      // Full grid with no repeats
+template <int BOX> bool parseGrid(const char* text, size_t length, uint8_t cells[]); // Reads one puzzle line
+template <int BOX> void formatGrid(const uint8_t cells[], char* text);             // Writes T::CELLS characters
+char digitChar(int digit);                       // 1-9 then A-P, '0' for empty
+int charDigit(char ch);                          // Inverse of digitChar, -1 if not a digit
+
+/**
+ * @param digit Digit 0-25 (0 = empty)
+ * @return '1'-'9' for 1-9, 'A'.. for 10 and up, '0' for empty
+ */
+inline char digitChar(int digit)
+{
+    return digit <= 9 ? '0' + digit : 'A' + digit - 10;
+}
+
+/**
+ * @param ch Character to read; '.' counts as empty, letters are case-insensitive
+ * @return Digit 0-35, or -1 if ch is not a digit character
+ */
+inline int charDigit(char ch)
+{
+    if (ch == '.') return 0;
+    if (ch >= '0' && ch <= '9') return ch - '0';
+    if (ch >= 'A' && ch <= 'Z') return ch - 'A' + 10;
+    if (ch >= 'a' && ch <= 'z') return ch - 'a' + 10;
+    return -1;
+}
+
+/**
+ * Empties every cell and clears all masks
+ */
+template <int BOX, typename Rules>
+inline void GridBoard<BOX, Rules>::clear()
+{
+    memset(this, 0, sizeof(*this));
+}
+
+/**
+ * Replaces all digits and rebuilds the unit masks
+ * @param values T::CELLS digits in row-major order, 0 for empty
+ * @return False if a value is out of range or a unit repeats a digit
+ */
+template <int BOX, typename Rules>
+bool GridBoard<BOX, Rules>::load(const uint8_t values[])
+{
+    clear();
+    bool valid = true;
+    for (int cell = 0; cell < T::CELLS; cell++)
+    {
+        if (values[cell] > T::N) return false;
+        if (values[cell] == 0) continue;
+        if (!canPlace(cell, values[cell])) valid = false;
+        set(cell, values[cell]);
+    }
+    return valid;
+}
+
+/**
+ * Places a digit in an empty cell and marks it in the unit masks
+ * @param cell Cell index
+ * @param num Digit to place (1-N)
+ */
+template <int BOX, typename Rules>
+inline void GridBoard<BOX, Rules>::set(int cell, int num)
+{
+    Mask bit = (Mask)1 << (num - 1);
+    const uint8_t* units = ruleTables<Rules>.cellUnits[cell];
+    cells[cell] = num;
+    unitMask[units[0]] |= bit;                   // Row, column and box
+    unitMask[units[1]] |= bit;
+    unitMask[units[2]] |= bit;
+    for (int i = 3; i < Rules::CELL_UNITS; i++)
+    {
+        unitMask[units[i]] |= bit;
+    }
+}
+
+/**
+ * Empties a cell and releases its digit in the unit masks
+ * @param cell Cell index
+ */
+template <int BOX, typename Rules>
+inline void GridBoard<BOX, Rules>::erase(int cell)
+{
+    if (cells[cell] == 0) return;
+    Mask bit = ~((Mask)1 << (cells[cell] - 1));
+    const uint8_t* units = ruleTables<Rules>.cellUnits[cell];
+    unitMask[units[0]] &= bit;
+    unitMask[units[1]] &= bit;
+    unitMask[units[2]] &= bit;
+    for (int i = 3; i < Rules::CELL_UNITS; i++)
+    {
+        unitMask[units[i]] &= bit;
+    }
+    cells[cell] = 0;
+}
+
+/**
+ * Padded unit slots repeat the row and padded peers are the always-empty
+ * last cell, so every cell runs the same fixed number of ORs
+ * @param cell Cell index
+ * @return Mask of digits not used by the cell's units or extra peers
+ */
+template <int BOX, typename Rules>
+inline typename GridBoard<BOX, Rules>::Mask GridBoard<BOX, Rules>::candidates(int cell) const
+{
+    const uint8_t* units = ruleTables<Rules>.cellUnits[cell];
+    Mask used = unitMask[units[0]] | unitMask[units[1]] | unitMask[units[2]];
+    for (int i = 3; i < Rules::CELL_UNITS; i++)
+    {
+        used |= unitMask[units[i]];
+    }
+    for (int i = 0; i < Rules::PEERS; i++)
+    {
+        used |= (Mask)((1u << cells[ruleTables<Rules>.peers[cell][i]]) >> 1);
+    }
+    return ~used & T::ALL_DIGITS;
+}
+
+/**
+ * @param cell Cell index
+ * @param num Digit to check (1-N)
+ * @return True if no unit or peer of the cell already holds num
+ */
+template <int BOX, typename Rules>
+inline bool GridBoard<BOX, Rules>::canPlace(int cell, int num) const
+{
+    return (candidates(cell) >> (num - 1)) & 1;
+}
+
+/**
+ * GridSolver constructor - Starts from an empty grid
+ */
+template <int BOX, typename Rules>
+GridSolver<BOX, Rules>::GridSolver()
+{
+    board.clear();
+    memset(solution, 0, sizeof(solution));
+    trailSize = 0;
+    emptyCount = T::CELLS;
+    solutionsFound = 0;
+    solutionLimit = 1;
+    rng = nullptr;
+    control = nullptr;
+    ::resetStats(stats);
+}
+
+/**
+ * Loads a puzzle into the solver
+ * @param puzzle T::CELLS digits in row-major order, 0 for empty cells
+ * @return False if a value is out of range or two givens conflict
+ */
+template <int BOX, typename Rules>
+bool GridSolver<BOX, Rules>::load(const uint8_t puzzle[])
+{
+    trailSize = 0;
+    bool valid = board.load(puzzle);
+    emptyCount = 0;
+    for (int cell = 0; cell < T::CELLS; cell++)
+    {
+        if (board.cells[cell] == 0) emptyCount++;
+    }
+    return valid;
+}
+
+/**
+ * Places a digit and records it on the trail
+ */
+template <int BOX, typename Rules>
+inline void GridSolver<BOX, Rules>::place(int cell, int num)
+{
+    board.set(cell, num);
+    trail[trailSize++] = cell;
+    emptyCount--;
+}
+
+/**
+ * Removes every placement made after the given trail position
+ * @param mark Trail size to roll back to
+ */
+template <int BOX, typename Rules>
+inline void GridSolver<BOX, Rules>::undo(int mark)
+{
+    while (trailSize > mark)
+    {
+        board.erase(trail[--trailSize]);
+        emptyCount++;
+    }
+}
+
+/**
+ * Fills naked and hidden singles until neither applies
+ * @return False if a contradiction was found, true otherwise
+ */
+template <int BOX, typename Rules>
+bool GridSolver<BOX, Rules>::propagate()
+{
+    STATS_TIMER(stats, PHASE_PROPAGATE);
+    bool changed = true;
+    while (changed)
+    {
+        changed = false;
+
+        // Naked singles
+        for (int cell = 0; cell < T::CELLS; cell++)
+        {
+            if (board.cells[cell] != 0) continue;
+            Mask cand = board.candidates(cell);
+            if (cand == 0) return false;
+            if ((cand & (cand - 1)) == 0)
+            {
+                place(cell, __builtin_ctz(cand) + 1);
+                STATS_INC(stats, propagations);
+                changed = true;
+            }
+        }
+
+        // Hidden singles
+        for (int unit = 0; unit < R::UNITS; unit++)
+        {
+            const typename T::Index* members = ruleTables<Rules>.units[unit];
+            Mask once = 0, twice = 0, used = 0;
+            for (int i = 0; i < T::N; i++)
+            {
+                int cell = members[i];
+                if (board.cells[cell] != 0)
+                {
+                    used |= (Mask)1 << (board.cells[cell] - 1);
+                    continue;
+                }
+                Mask cand = board.candidates(cell);
+                twice |= once & cand;
+                once |= cand;
+            }
+            if ((once | used) != T::ALL_DIGITS) return false;  // Some digit has nowhere to go
+
+            Mask hidden = once & ~twice;
+            while (hidden)
+            {
+                Mask bit = hidden & -hidden;
+                hidden &= hidden - 1;
+                for (int i = 0; i < T::N; i++)
+                {
+                    int cell = members[i];
+                    if (board.cells[cell] == 0 && (board.candidates(cell) & bit))
+                    {
+                        place(cell, __builtin_ctz(bit) + 1);
+                        STATS_INC(stats, propagations);
+                        changed = true;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * @return Empty cell with the fewest candidates (stops early at two)
+ */
+template <int BOX, typename Rules>
+int GridSolver<BOX, Rules>::branchCell() const
+{
+    int best = -1;
+    int bestCount = T::N + 1;
+    for (int cell = 0; cell < T::CELLS && bestCount > 2; cell++)
+    {
+        if (board.cells[cell] != 0) continue;
+        int count = __builtin_popcount(board.candidates(cell));
+        if (count < bestCount)
+        {
+            best = cell;
+            bestCount = count;
+        }
+    }
+    return best;
+}
+
+/**
+ * Propagates, then branches on the most constrained empty cell. In a
+ * parallel search every solution is also counted in the shared control,
+ * and a raised stop ends the search at the next node.
+ * @return True once the solution limit is reached, false to keep searching
+ */
+template <int BOX, typename Rules>
+bool GridSolver<BOX, Rules>::search()
+{
+    STATS_INC(stats, nodes);
+    if (control && control->stop.load(std::memory_order_relaxed)) return true;
+    int mark = trailSize;
+    if (!propagate())
+    {
+        undo(mark);
+        return false;
+    }
+
+    if (emptyCount == 0)
+    {
+        if (solutionsFound == 0)
+        {
+            memcpy(solution, board.cells, sizeof(solution));
+        }
+        solutionsFound++;
+        undo(mark);
+        if (control && control->found.fetch_add(1, std::memory_order_relaxed) + 1 >= control->limit)
+        {
+            control->stop.store(true, std::memory_order_relaxed);
+            return true;
+        }
+        return solutionsFound >= solutionLimit;
+    }
+
+    int best = branchCell();
+    int branchMark = trailSize;
+    Mask cand = board.candidates(best);
+    while (cand)
+    {
+        Mask rest = cand;
+        if (rng)
+        {
+            for (int skip = rng->below(__builtin_popcount(cand)); skip > 0; skip--) rest &= rest - 1;
+        }
+        Mask bit = rest & -rest;
+        cand &= ~bit;
+        place(best, __builtin_ctz(bit) + 1);
+        STATS_INC(stats, guesses);
+        STATS_ENTER(stats);
+        bool done = search();
+        STATS_LEAVE(stats);
+        if (done)
+        {
+            undo(mark);
+            return true;
+        }
+        undo(branchMark);
+        STATS_INC(stats, backtracks);
+    }
+    undo(mark);
+    return false;
+}
+
+/**
+ * Solves the loaded puzzle
+ * @return True if a solution was found, false if unsolvable
+ */
+template <int BOX, typename Rules>
+bool GridSolver<BOX, Rules>::solve()
+{
+    return countSolutions(1) == 1;
+}
+
+/**
+ * Solves the loaded puzzle, branching on digits in random order
+ * @param random Generator that drives the branch order
+ * @return True if a solution was found, false if unsolvable
+ */
+template <int BOX, typename Rules>
+bool GridSolver<BOX, Rules>::solveRandom(Xoshiro256& random)
+{
+    rng = &random;
+    bool solved = countSolutions(1) == 1;
+    rng = nullptr;
+    return solved;
+}
+
+/**
+ * Counts solutions of the loaded puzzle, stopping early at the limit
+ * @param limit Maximum number of solutions to look for
+ * @return Number of solutions found (at most limit)
+ */
+template <int BOX, typename Rules>
+int GridSolver<BOX, Rules>::countSolutions(int limit)
+{
+    STATS_TIMER(stats, PHASE_SOLVE);
+    solutionsFound = 0;
+    solutionLimit = limit;
+    search();
+    return solutionsFound;
+}
+
+/**
+ * Copies the first solution found by the last solve or count
+ * @param out [out] Receives T::CELLS digits in row-major order
+ */
+template <int BOX, typename Rules>
+void GridSolver<BOX, Rules>::getSolution(uint8_t out[]) const
+{
+    memcpy(out, solution, sizeof(solution));
+}
+
+/**
+ * Adds a given to the loaded puzzle without reloading it
+ * @param cell Cell index, must be empty
+ * @param num Digit to place (1-N)
+ * @return False if the digit conflicts with the cell's units or peers
+ */
+template <int BOX, typename Rules>
+bool GridSolver<BOX, Rules>::setGiven(int cell, int num)
+{
+    if (board.cells[cell] != 0 || !board.canPlace(cell, num)) return false;
+    board.set(cell, num);
+    emptyCount--;
+    return true;
+}
+
+/**
+ * Removes a given from the loaded puzzle without reloading it
+ * @param cell Cell index
+ */
+template <int BOX, typename Rules>
+void GridSolver<BOX, Rules>::clearGiven(int cell)
+{
+    if (board.cells[cell] == 0) return;
+    board.erase(cell);
+    emptyCount++;
+}
+
+/**
+ * @param cell Cell index
+ * @return Digit given in the cell, 0 if empty
+ */
+template <int BOX, typename Rules>
+int GridSolver<BOX, Rules>::getGiven(int cell) const
+{
+    return board.cells[cell];
+}
+
+/**
+ * Applies singles to the loaded puzzle without guessing, so a parallel
+ * search can split the tree at the returned cell
+ * @param cells [out] Grid after propagation (the solution if solved)
+ * @param cell [out] Most constrained empty cell, when branching
+ * @param digits [out] Candidates of that cell, one subtree each
+ * @return Whether the puzzle has no solution, is solved, or needs a branch
+ */
+template <int BOX, typename Rules>
+SplitResult GridSolver<BOX, Rules>::split(uint8_t cells[], int& cell, Mask& digits)
+{
+    int mark = trailSize;
+    bool consistent = propagate();
+    memcpy(cells, board.cells, T::CELLS);
+    SplitResult result = !consistent ? SPLIT_CONFLICT : emptyCount == 0 ? SPLIT_SOLVED : SPLIT_BRANCH;
+    if (result == SPLIT_BRANCH)
+    {
+        cell = branchCell();
+        digits = board.candidates(cell);
+    }
+    undo(mark);
+    return result;
+}
+
+/**
+ * Makes the following searches part of a parallel search
+ * @param shared Control shared by every solver of that search, nullptr to
+ *        search alone again
+ */
+template <int BOX, typename Rules>
+void GridSolver<BOX, Rules>::setControl(SearchControl* shared)
+{
+    control = shared;
+}
+
+/**
+ * @return Counters accumulated since the last resetStats
+ */
+template <int BOX, typename Rules>
+const SolverStats& GridSolver<BOX, Rules>::getStats() const
+{
+    return stats;
+}
+
+/**
+ * Zeroes the counters and phase timers
+ */
+template <int BOX, typename Rules>
+void GridSolver<BOX, Rules>::resetStats()
+{
+    ::resetStats(stats);
+}
+
+/**
+ * GridGenerator constructor
+ * @param seed Seed for the generator's random engine
+ */
+template <int BOX, typename Rules>
+GridGenerator<BOX, Rules>::GridGenerator(uint64_t seed) : rng(seed)
+{
+}
+
+/**
+ * Restarts the random sequence from a new seed
+ * @param seed Seed for the generator's random engine
+ */
+template <int BOX, typename Rules>
+void GridGenerator<BOX, Rules>::reseed(uint64_t seed)
+{
+    rng.reseed(seed);
+}
+
+/**
+ * @return Current state of the generator's random engine
+ */
+template <int BOX, typename Rules>
+const Xoshiro256& GridGenerator<BOX, Rules>::getEngine() const
+{
+    return rng;
+}
+
+/**
+ * Continues a random sequence from a state taken with getEngine, so several
+ * callers can share one generator and each keep its own sequence
+ * @param engine Engine state to continue from
+ */
+template <int BOX, typename Rules>
+void GridGenerator<BOX, Rules>::setEngine(const Xoshiro256& engine)
+{
+    rng = engine;
+}
+
+/**
+ * @param bound Exclusive upper bound
+ * @return Uniform random value in [0, bound)
+ */
+template <int BOX, typename Rules>
+uint32_t GridGenerator<BOX, Rules>::randomBelow(uint32_t bound)
+{
+    return rng.below(bound);
+}
+
+/**
+ * @return Counters of the internal solver, covering every solve and
+ *         uniqueness check since the last resetStats
+ */
+template <int BOX, typename Rules>
+const SolverStats& GridGenerator<BOX, Rules>::getStats() const
+{
+    return solver.getStats();
+}
+
+/**
+ * Zeroes the internal solver's counters
+ */
+template <int BOX, typename Rules>
+void GridGenerator<BOX, Rules>::resetStats()
+{
+    solver.resetStats();
+}
+
+/**
+ * Fills a grid with a random completed grid of the rule set by solving the
+ * empty grid with shuffled branch order
+ * @param grid [out] Receives T::CELLS digits
+ */
+template <int BOX, typename Rules>
+void GridGenerator<BOX, Rules>::randomSolution(uint8_t grid[])
+{
+    uint8_t empty[T::CELLS] = {};
+    solver.load(empty);
+    solver.solveRandom(rng);
+    solver.getSolution(grid);
+}
+
+/**
+ * Checks whether a clue can be removed from the loaded, uniquely solvable
+ * puzzle. Any second solution without the clue must differ from the known
+ * one in the clue's own cell, so instead of counting to two (which always
+ * re-finds the known solution first) this tries each other digit in the
+ * cell and stops at the first one that solves.
+ * @param cell Cell of the clue, already cleared in the solver
+ * @param num Digit the clue held
+ * @return True if the puzzle needs the clue to stay unique
+ */
+template <int BOX, typename Rules>
+bool GridGenerator<BOX, Rules>::clueNeeded(int cell, int num)
+{
+    for (int digit = 1; digit <= T::N; digit++)
+    {
+        if (digit == num || !solver.setGiven(cell, digit)) continue;
+        bool solvable = solver.solve();
+        solver.clearGiven(cell);
+        if (solvable) return true;
+    }
+    return false;
+}
+
+/**
+ * Removes clues one at a time in random order, keeping a removal only if
+ * the puzzle stays unique
+ * @param solution Completed grid valid under the rule set
+ * @param puzzle [out] Resulting puzzle with 0 for empty cells
+ * @param holes Number of cells to try to empty
+ * @return Number of cells actually emptied (less than holes if no further
+ *         clue could be removed without losing uniqueness)
+ */
+template <int BOX, typename Rules>
+int GridGenerator<BOX, Rules>::removeClues(const uint8_t solution[], uint8_t puzzle[], int holes)
+{
+    solver.load(solution);
+
+    int order[T::CELLS];
+    for (int i = 0; i < T::CELLS; i++) order[i] = i;
+    for (int i = T::CELLS - 1; i > 0; i--)
+    {
+        int j = rng.below(i + 1);
+        int tmp = order[i];
+        order[i] = order[j];
+        order[j] = tmp;
+    }
+
+    int removed = 0;
+    for (int i = 0; i < T::CELLS && removed < holes; i++)
+    {
+        int cell = order[i];
+        int num = solver.getGiven(cell);
+        solver.clearGiven(cell);
+        if (!clueNeeded(cell, num)) removed++;
+        else solver.setGiven(cell, num);  // Clue is needed, put it back
+    }
+
+    for (int cell = 0; cell < T::CELLS; cell++)
+    {
+        puzzle[cell] = solver.getGiven(cell);
+    }
+    return removed;
+}
+
+/**
+ * Reduces a solved grid to a minimal puzzle: unique, and no clue can be
+ * removed without losing uniqueness. One greedy pass over all cells in
+ * random order already gives a minimal puzzle (a clue needed once stays
+ * needed as more clues go), so restarts only try other orders and keep
+ * the puzzle with the fewest clues.
+ * @param solution Completed grid valid under the rule set
+ * @param puzzle [out] Minimal puzzle with 0 for empty cells
+ * @param restarts Greedy passes to run (at least one)
+ * @return Clues in the puzzle
+ */
+template <int BOX, typename Rules>
+int GridGenerator<BOX, Rules>::minimalPuzzle(const uint8_t solution[], uint8_t puzzle[], int restarts)
+{
+    uint8_t candidate[T::CELLS];
+    int best = T::CELLS + 1;
+    for (int pass = 0; pass < restarts || pass == 0; pass++)
+    {
+        int clues = T::CELLS - removeClues(solution, candidate, T::CELLS);
+        if (clues < best)
+        {
+            best = clues;
+            memcpy(puzzle, candidate, sizeof(candidate));
+        }
+    }
+    return best;
+}
+
+/**
+ * Checks a whole grid: every cell filled, no unit repeating a digit and no
+ * two peers of the rule set sharing one
+ * @param cells T::CELLS digits in row-major order
+ * @return True if the grid is a valid solution
+ */
+template <int BOX, typename Rules>
+bool isSolvedGridOf(const uint8_t cells[])
+{
+    typedef GridTraits<BOX> T;
+    typedef RuleTablesOf<Rules> R;
+    for (int unit = 0; unit < R::UNITS; unit++)
+    {
+        typename T::Mask seen = 0;
+        for (int i = 0; i < T::N; i++)
+        {
+            int digit = cells[ruleTables<Rules>.units[unit][i]];
+            if (digit < 1 || digit > T::N) return false;
+            seen |= (typename T::Mask)1 << (digit - 1);
+        }
+        if (seen != T::ALL_DIGITS) return false;
+    }
+    for (int cell = 0; cell < T::CELLS; cell++)
+    {
+        for (int i = 0; i < Rules::PEERS; i++)
+        {
+            int peer = ruleTables<Rules>.peers[cell][i];
+            if (peer < T::CELLS && cells[peer] == cells[cell]) return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Parses one puzzle line of T::CELLS characters ('0' or '.' for empty,
+ * digits above 9 as letters)
+ * @param text Start of the line
+ * @param length Line length without the newline
+ * @param cells [out] Parsed puzzle
+ * @return True if the line starts with a complete puzzle
+ */
+template <int BOX>
+bool parseGrid(const char* text, size_t length, uint8_t cells[])
+{
+    typedef GridTraits<BOX> T;
+    if (length < (size_t)T::CELLS) return false;
+    for (int i = 0; i < T::CELLS; i++)
+    {
+        int digit = charDigit(text[i]);
+        if (digit < 0 || digit > T::N) return false;
+        cells[i] = digit;
+    }
+    return true;
+}
+
+/**
+ * Formats a grid as T::CELLS characters, no terminator
+ * @param cells Digits in row-major order
+ * @param text [out] Receives the characters
+ */
+template <int BOX>
+void formatGrid(const uint8_t cells[], char* text)
+{
+    for (int i = 0; i < GridTraits<BOX>::CELLS; i++)
+    {
+        text[i] = digitChar(cells[i]);
+    }
+}
+
+#endif
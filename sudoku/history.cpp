@@ -0,0 +1,148 @@
+#include "history.h"
+
+/**
+ * MoveHistory constructor - Starts with no moves
+ */
+MoveHistory::MoveHistory()
+{
+    clear();
+}
+
+/**
+ * Forgets every move and branch point, e.g. when a new puzzle starts;
+ * allocates nothing, so starting a game stays allocation-free
+ */
+void MoveHistory::clear()
+{
+    nodes.clear();
+    redoStack.clear();
+    branches.clear();
+    current = 0;
+}
+
+/**
+ * Adds a move after the current position. Undone moves can no longer be
+ * redone, but stay in the tree for any branch point that reaches them.
+ * @param move Delta of the move just played
+ */
+void MoveHistory::record(const MoveDelta& move)
+{
+    if (nodes.empty()) nodes.push_back(Node());  // Start of the game
+    if (nodes.size() == MAX_HISTORY_NODES) prune();
+    Node node;
+    node.move = move;
+    node.parent = current;
+    node.depth = nodes[current].depth + 1;
+    nodes.push_back(node);
+    current = nodes.size() - 1;
+    redoStack.clear();
+}
+
+/**
+ * Steps back one move
+ * @param move [out] Delta of the move to take back
+ * @return False at the start of the game
+ */
+bool MoveHistory::undo(MoveDelta& move)
+{
+    if (current == 0) return false;
+    move = nodes[current].move;
+    redoStack.push_back(current);
+    current = nodes[current].parent;
+    return true;
+}
+
+/**
+ * Steps forward to the move undone last
+ * @param move [out] Delta of the move to play again
+ * @return False if nothing was undone since the last move or restore
+ */
+bool MoveHistory::redo(MoveDelta& move)
+{
+    if (redoStack.empty()) return false;
+    current = redoStack.back();
+    redoStack.pop_back();
+    move = nodes[current].move;
+    return true;
+}
+
+/**
+ * Names the current position; an existing branch point with the same name
+ * is moved here
+ * @param name Branch point name
+ * @return False if the name is new and MAX_BRANCH_POINTS are in use
+ */
+bool MoveHistory::mark(const std::string& name)
+{
+    for (Branch& branch : branches)
+    {
+        if (branch.name == name)
+        {
+            branch.node = current;
+            return true;
+        }
+    }
+    if (branches.size() == MAX_BRANCH_POINTS) return false;
+    branches.push_back(Branch{name, current});
+    return true;
+}
+
+/**
+ * Drops every node that is not on the line to the current position, an
+ * undone move or a branch point, and renumbers the rest in place. Nodes are
+ * only ever added after their parent, so renumbering in order keeps each
+ * parent before its children.
+ */
+void MoveHistory::prune()
+{
+    std::vector<uint32_t> renumber(nodes.size(), 0);  // 0 = dropped, else new index + 1
+    auto keep = [&](uint32_t node) {
+        while (renumber[node] == 0)
+        {
+            renumber[node] = 1;
+            if (node == 0) break;
+            node = nodes[node].parent;
+        }
+    };
+    keep(current);
+    for (uint32_t node : redoStack) keep(node);
+    for (const Branch& branch : branches) keep(branch.node);
+
+    uint32_t kept = 0;
+    for (uint32_t i = 0; i < nodes.size(); i++)
+    {
+        if (renumber[i] == 0) continue;
+        Node node = nodes[i];
+        node.parent = i == 0 ? 0 : renumber[node.parent] - 1;
+        nodes[kept] = node;
+        renumber[i] = ++kept;
+    }
+    nodes.resize(kept);
+    current = renumber[current] - 1;
+    for (uint32_t& node : redoStack) node = renumber[node] - 1;
+    for (Branch& branch : branches) branch.node = renumber[branch.node] - 1;
+}
+
+/**
+ * @return Moves between the start of the game and the current position
+ */
+size_t MoveHistory::undoDepth() const
+{
+    return current == 0 ? 0 : nodes[current].depth;
+}
+
+/**
+ * @return Undone moves that redo can play again
+ */
+size_t MoveHistory::redoDepth() const
+{
+    return redoStack.size();
+}
+
+/**
+ * @return Moves stored on every branch, the start excluded
+ */
+size_t MoveHistory::size() const
+{
+    return nodes.empty() ? 0 : nodes.size() - 1;
+}
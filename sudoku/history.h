@@ -0,0 +1,110 @@
+#ifndef HISTORY_H
+#define HISTORY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+const uint8_t DELTA_WAS_FIXED = 0x80;            // MoveDelta::previous flag: the cell was fixed
+const size_t MAX_BRANCH_POINTS = 16;             // Named positions kept per game
+const size_t MAX_HISTORY_NODES = 2048;           // Tree nodes kept per game, about 24 KB
+
+// Every move on a line fills an empty cell, so a line is at most 81 moves
+// deep and the lines kept by a prune always fit
+static_assert(MAX_HISTORY_NODES > 81 * (MAX_BRANCH_POINTS + 2) + 1, "History bound too small to prune into");
+
+// One move as a 4-byte delta: what it changed, so it can be taken back or
+// played again without checking it against the solution
+struct MoveDelta {
+    uint8_t op;                                  // JOURNAL_PLACE or JOURNAL_HINT (journal.h)
+    uint8_t cell;                                // Cell index (0-80)
+    uint8_t digit;                               // Digit placed or tried
+    uint8_t previous;                            // Digit the cell held before, 0 if empty, plus DELTA_WAS_FIXED
+};
+
+// Undo/redo history kept as a tree of move deltas. Each move points at the
+// move before it, so a what-if line shares every move up to where it
+// branched off instead of copying the game. Undo steps to the parent, redo
+// back down; a named branch point is a node, and restoring it walks up to
+// the common ancestor and down again, one delta per move in between.
+// About 12 bytes per move, on every branch. The tree is bounded: when it
+// reaches MAX_HISTORY_NODES, lines that neither redo nor a branch point can
+// reach are dropped.
+class MoveHistory {
+private:
+    struct Node {
+        MoveDelta move;
+        uint32_t parent;                         // Move before this one, 0 for the start
+        uint32_t depth;                          // Moves from the start of the game
+    };
+    struct Branch {
+        std::string name;
+        uint32_t node;
+    };
+
+    std::vector<Node> nodes;                     // nodes[0] is the start of the game, added with the first move
+    std::vector<uint32_t> redoStack;             // Undone moves, next one to redo on top
+    std::vector<Branch> branches;                // Named positions, few per game
+    uint32_t current;                            // Last move played, 0 at the start
+
+    void prune();                                // Drops nodes off the current, redo and branch lines
+
+public:
+    MoveHistory();
+    void clear();                                // Forgets every move and branch point
+    void record(const MoveDelta& move);          // Adds a move after the current one, dropping redo
+    bool undo(MoveDelta& move);                  // Steps back one move
+    bool redo(MoveDelta& move);                  // Steps forward one undone move
+    bool mark(const std::string& name);          // Names the current position, false if too many names
+    template <typename Apply>
+    bool restore(const std::string& name, Apply apply); // Walks to a named position
+    size_t undoDepth() const;                    // Moves that can be undone
+    size_t redoDepth() const;                    // Moves that can be redone
+    size_t size() const;                         // Moves stored, on every branch
+};
+
+/**
+ * Walks from the current position to a named one: moves only on the
+ * current line are taken back (latest first), then moves only on the
+ * target line are replayed (earliest first). The redo stack is used as
+ * scratch and ends up empty.
+ * @param name Branch point set by mark
+ * @param apply Called as apply(move, forward) for each move, forward false
+ *        to take it back
+ * @return False if no branch point has that name
+ */
+template <typename Apply>
+bool MoveHistory::restore(const std::string& name, Apply apply)
+{
+    size_t i = 0;
+    while (i < branches.size() && branches[i].name != name) i++;
+    if (i == branches.size()) return false;
+    uint32_t target = branches[i].node;
+
+    redoStack.clear();
+    uint32_t from = current;
+    uint32_t to = target;
+    while (from != to)
+    {
+        if (nodes[from].depth >= nodes[to].depth)
+        {
+            apply(nodes[from].move, false);
+            from = nodes[from].parent;
+        }
+        else
+        {
+            redoStack.push_back(to);
+            to = nodes[to].parent;
+        }
+    }
+    while (!redoStack.empty())
+    {
+        apply(nodes[redoStack.back()].move, true);
+        redoStack.pop_back();
+    }
+    current = target;
+    return true;
+}
+
+#endif
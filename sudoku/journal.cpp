@@ -0,0 +1,509 @@
+#include "journal.h"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <algorithm>
+#include <ctime>
+
+/**
+ * Keeps a second name for a file under a suffix no earlier run has used,
+ * FILE.unreadable.TIME or FILE.unreadable.TIME-N, so copies left by earlier
+ * crashes are never overwritten and never block this one
+ * @param file File to keep
+ * @param kept [out] Name it is kept under
+ * @return False if no free name could be linked
+ */
+static bool keepUnreadable(const char* file, std::string& kept)
+{
+    std::string base = std::string(file) + ".unreadable." + std::to_string((long long)time(nullptr));
+    for (int attempt = 0; attempt < 1000; attempt++)
+    {
+        kept = attempt == 0 ? base : base + "-" + std::to_string(attempt);
+        if (link(file, kept.c_str()) == 0) return true;
+        if (errno != EEXIST) return false;
+    }
+    return false;
+}
+
+/**
+ * Writes all of a buffer at an offset, retrying short writes
+ * @return False on a write error
+ */
+static bool writeFully(int fd, const char* data, size_t size, off_t offset)
+{
+    size_t written = 0;
+    while (written < size)
+    {
+        ssize_t n = pwrite(fd, data + written, size - written, offset + written);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        written += n;
+    }
+    return true;
+}
+
+/**
+ * Makes a rename in a file's directory durable
+ * @param file Path of a file in the directory
+ * @return False if the directory cannot be opened or synced
+ */
+static bool syncDirectory(const std::string& file)
+{
+    size_t slash = file.rfind('/');
+    std::string dir = slash == std::string::npos ? "." : slash == 0 ? "/" : file.substr(0, slash);
+    int dirFd = ::open(dir.c_str(), O_RDONLY | O_DIRECTORY);
+    if (dirFd < 0) return false;
+    bool synced = fsync(dirFd) == 0;
+    ::close(dirFd);
+    return synced;
+}
+
+/**
+ * Fills in a journal file header
+ * @param header [out] Header for the current version
+ */
+static void initHeader(JournalHeader& header)
+{
+    memset(&header, 0, sizeof(header));
+    header.magic = JOURNAL_MAGIC;
+    header.version = JOURNAL_VERSION;
+    header.recordSize = sizeof(JournalRecord);
+}
+
+/**
+ * Walks the records in journal bytes, stopping at the first one that is
+ * torn or damaged (the tail of a write cut short by a crash)
+ * @param bytes Records as read from the file
+ * @param visit Called with each record and, for a snapshot, its SaveRecord
+ * @return Bytes of intact records
+ */
+template <typename Visit>
+static size_t forEachRecord(const std::string& bytes, Visit visit)
+{
+    size_t offset = 0;
+    while (offset + sizeof(JournalRecord) <= bytes.size())
+    {
+        JournalRecord record;
+        memcpy(&record, bytes.data() + offset, sizeof(record));
+        if (record.checksum != fnv1a((const uint8_t*)&record, offsetof(JournalRecord, checksum))) break;
+        size_t next = offset + sizeof(record);
+
+        SaveRecord snapshot;
+        const SaveRecord* saved = nullptr;
+        if (record.op == JOURNAL_SNAPSHOT)
+        {
+            if (next + sizeof(snapshot) > bytes.size()) break;
+            memcpy(&snapshot, bytes.data() + next, sizeof(snapshot));
+            if (snapshot.checksum != fnv1a((const uint8_t*)&snapshot, offsetof(SaveRecord, checksum))) break;
+            next += sizeof(snapshot);
+            saved = &snapshot;
+        }
+        visit(record, saved);
+        offset = next;
+    }
+    return offset;
+}
+
+/**
+ * Replays one move record onto a game. Counters are set, not incremented,
+ * so a record the game already reflects leaves it unchanged.
+ * @param record Move record (not a snapshot)
+ * @param game [in,out] Game in the record's slot
+ */
+void applyJournalRecord(const JournalRecord& record, GameData& game)
+{
+    bool places = record.op == JOURNAL_PLACE || record.op == JOURNAL_HINT;
+    if (places && record.cell < 81 && record.digit >= 1 && record.digit <= 9)
+    {
+        game.board.erase(record.cell);
+        game.board.set(record.cell, record.digit);
+        game.board.setFixed(record.cell, true);
+    }
+    if (record.op == JOURNAL_HINT) game.hintsUsed = record.count;
+    if (record.op == JOURNAL_WRONG) game.wrongAttempts = record.count;
+}
+
+/**
+ * MoveJournal constructor - No file is open until open() succeeds
+ * @param snapshots Open save store holding the snapshots
+ */
+MoveJournal::MoveJournal(SaveStore& snapshots) : store(snapshots)
+{
+    fd = -1;
+    nextTicket = 0;
+    fileSize = 0;
+    commits = 0;
+}
+
+/**
+ * MoveJournal destructor - Compacts and closes the file
+ */
+MoveJournal::~MoveJournal()
+{
+    close();
+}
+
+/**
+ * Opens a journal file, creating it if needed. Records left by a crash are
+ * replayed onto the latest snapshot of each slot (from the journal, or else
+ * the store) and compacted into the store, so recovery is snapshot plus
+ * journal. Slots whose moves have no readable base are listed by
+ * getUnreadable(), and the old journal is kept under getUnreadablePath().
+ * @param file Journal file path
+ * @return Records replayed, -1 if the store is not open or the file cannot
+ *         be opened, is not a journal or cannot be compacted
+ */
+long MoveJournal::open(const char* file)
+{
+    close();
+    unreadable.clear();
+    unreadablePath.clear();
+    if (store.capacity() == 0) return -1;
+    path = file;
+    fd = ::open(file, O_RDWR | O_CREAT, 0644);
+    if (fd < 0) return -1;
+
+    struct stat info;
+    if (fstat(fd, &info) != 0)
+    {
+        close();
+        return -1;
+    }
+    JournalHeader header;
+    if (info.st_size == 0)
+    {
+        initHeader(header);
+        if (!writeFully(fd, (const char*)&header, sizeof(header), 0) || fdatasync(fd) != 0)
+        {
+            close();
+            return -1;
+        }
+        fileSize = sizeof(header);
+        return 0;
+    }
+    if (info.st_size < (off_t)sizeof(header) || pread(fd, &header, sizeof(header), 0) != (ssize_t)sizeof(header) ||
+        header.magic != JOURNAL_MAGIC || header.version != JOURNAL_VERSION || header.recordSize != sizeof(JournalRecord))
+    {
+        close();
+        return -1;
+    }
+    fileSize = info.st_size;
+
+    // Replay in order: a snapshot restarts its slot, moves apply on top of
+    // the latest snapshot (from the journal, or else the store)
+    struct Replayed {
+        GameData game;
+        bool valid;
+    };
+    std::string bytes;
+    std::unordered_map<uint64_t, Replayed> games;
+    long replayed = 0;
+    if (!readAll(bytes))
+    {
+        close();
+        return -1;
+    }
+    forEachRecord(bytes, [&](const JournalRecord& record, const SaveRecord* saved) {
+        auto slot = games.emplace(record.id, Replayed());
+        Replayed& game = slot.first->second;
+        if (saved)
+        {
+            game.valid = decodeSave(*saved, game.game);
+        }
+        else
+        {
+            if (slot.second) game.valid = store.load(record.id, game.game);
+            if (game.valid) applyJournalRecord(record, game.game);
+        }
+        replayed++;
+    });
+    for (auto& entry : games)
+    {
+        if (entry.second.valid) dirty[entry.first] = entry.second.game;
+        else unreadable.push_back(entry.first);
+    }
+    std::sort(unreadable.begin(), unreadable.end());
+    if (!unreadable.empty() && !keepUnreadable(file, unreadablePath))
+    {
+        close();
+        return -1;
+    }
+
+    fileSize = sizeof(header) + bytes.size();
+    if (!compact())
+    {
+        close();
+        return -1;
+    }
+    return replayed;
+}
+
+/**
+ * Compacts and closes the journal; games journaled to it stop journaling
+ * at their next move
+ */
+void MoveJournal::close()
+{
+    if (fd >= 0)
+    {
+        compact();
+        ::close(fd);
+    }
+    fd = -1;
+    pending.clear();
+    tickets.clear();
+    dirty.clear();
+    fileSize = 0;
+}
+
+/**
+ * Stamps a record's checksum and appends it to the buffer
+ * @param record Record with every field but the checksum set
+ */
+void MoveJournal::push(const JournalRecord& record)
+{
+    JournalRecord stamped = record;
+    stamped.checksum = fnv1a((const uint8_t*)&stamped, offsetof(JournalRecord, checksum));
+    pending.append((const char*)&stamped, sizeof(stamped));
+}
+
+/**
+ * Buffers a snapshot record followed by the game's SaveRecord
+ * @param id Game ID (save slot)
+ * @param game State of the slot
+ */
+void MoveJournal::pushSnapshot(uint64_t id, const GameData& game)
+{
+    JournalRecord record;
+    memset(&record, 0, sizeof(record));
+    record.id = id;
+    record.op = JOURNAL_SNAPSHOT;
+    record.cell = 0xFF;
+    push(record);
+    SaveRecord saved;
+    encodeSave(game, saved);
+    pending.append((const char*)&saved, sizeof(saved));
+}
+
+/**
+ * Reads every byte after the header
+ * @param bytes [out] Journal records, possibly ending in a torn record
+ * @return False on a read error
+ */
+bool MoveJournal::readAll(std::string& bytes) const
+{
+    bytes.resize(fileSize - sizeof(JournalHeader));
+    size_t done = 0;
+    while (done < bytes.size())
+    {
+        ssize_t n = pread(fd, &bytes[done], bytes.size() - done, sizeof(JournalHeader) + done);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) break;
+        done += n;
+    }
+    bytes.resize(done);
+    return done == fileSize - sizeof(JournalHeader);
+}
+
+/**
+ * Starts journaling a game under a save slot: buffers a snapshot record, so
+ * later moves have a base to replay onto; the slot is saved once the
+ * snapshot is committed. A game that was journaled under the same ID before
+ * stops journaling.
+ * @param id Game ID (save slot)
+ * @param game Current state of the game
+ * @return Ticket the game passes to append, 0 on failure
+ */
+uint32_t MoveJournal::snapshot(uint64_t id, const GameData& game)
+{
+    if (fd < 0) return 0;
+    pushSnapshot(id, game);
+    dirty[id] = game;
+
+    if (++nextTicket == 0) nextTicket++;
+    tickets[id] = nextTicket;
+    return nextTicket;
+}
+
+/**
+ * Buffers one move and remembers the slot's new state for load() and the
+ * next compaction; the move is durable after the next commit
+ * @param id Game ID (save slot)
+ * @param ticket Ticket from snapshot
+ * @param op JOURNAL_PLACE, JOURNAL_HINT or JOURNAL_WRONG
+ * @param cell Cell index (0-80), -1 if the move has none
+ * @param digit Digit placed or tried
+ * @param game Game after the move
+ * @return False if no journal is open or another game took over the ID
+ */
+bool MoveJournal::append(uint64_t id, uint32_t ticket, JournalOp op, int cell, int digit, const GameData& game)
+{
+    auto owner = tickets.find(id);
+    if (fd < 0 || owner == tickets.end() || owner->second != ticket) return false;
+
+    JournalRecord record;
+    memset(&record, 0, sizeof(record));
+    record.id = id;
+    record.op = op;
+    record.cell = cell < 0 ? 0xFF : cell;
+    record.digit = digit;
+    if (op == JOURNAL_HINT) record.count = game.hintsUsed < 0xFF ? game.hintsUsed : 0xFF;
+    if (op == JOURNAL_WRONG) record.count = game.wrongAttempts < 0xFF ? game.wrongAttempts : 0xFF;
+    push(record);
+    dirty[id] = game;
+    return true;
+}
+
+/**
+ * Writes every buffered record with one write and one fdatasync
+ * @return False if no journal is open or the write or sync fails; the
+ *         records stay buffered for the next commit
+ */
+bool MoveJournal::commit()
+{
+    if (fd < 0) return false;
+    if (pending.empty()) return true;
+
+    if (!writeFully(fd, pending.data(), pending.size(), fileSize) || fdatasync(fd) != 0) return false;
+    fileSize += pending.size();
+    pending.clear();
+    commits++;
+    return true;
+}
+
+/**
+ * Replaces the journal with a new file holding one snapshot per changed
+ * slot: written and synced under a temporary name, then renamed over the
+ * journal, so a crash leaves either the old or the new file whole
+ * @return False if a write, sync or rename fails; the old journal is kept
+ */
+bool MoveJournal::rewrite()
+{
+    JournalHeader header;
+    initHeader(header);
+    pending.assign((const char*)&header, sizeof(header));
+    for (auto& entry : dirty) pushSnapshot(entry.first, entry.second);
+
+    std::string temp = path + ".tmp";
+    int out = ::open(temp.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    bool written = out >= 0 && writeFully(out, pending.data(), pending.size(), 0) && fdatasync(out) == 0 &&
+                   rename(temp.c_str(), path.c_str()) == 0;
+    size_t size = pending.size();
+    pending.clear();
+    if (!written)
+    {
+        if (out >= 0)
+        {
+            ::close(out);
+            unlink(temp.c_str());
+        }
+        return false;
+    }
+    syncDirectory(path);
+    ::close(fd);
+    fd = out;
+    fileSize = size;
+    return true;
+}
+
+/**
+ * Folds the journal into the store: commits, replaces the journal with
+ * snapshots of the changed slots, then writes those slots to the store and
+ * syncs it. A store record torn by a crash during the sync is still in the
+ * journal; the next compaction drops the snapshots the synced store holds.
+ * @return False if a write or sync fails; the changed slots stay in memory
+ *         and in the journal
+ */
+bool MoveJournal::compact()
+{
+    if (!commit() || !rewrite()) return false;
+    for (auto& entry : dirty)
+    {
+        if (!store.save(entry.first, entry.second)) return false;
+    }
+    if (!store.flush()) return false;
+    dirty.clear();
+    return true;
+}
+
+/**
+ * Loads the latest state of a slot: moves not yet compacted into the store
+ * come from memory
+ * @param id Game ID (save slot)
+ * @param game [out] Loaded game, untouched on failure
+ * @return False if the slot is empty or damaged
+ */
+bool MoveJournal::load(uint64_t id, GameData& game) const
+{
+    auto entry = dirty.find(id);
+    if (entry == dirty.end()) return store.load(id, game);
+    game = entry->second;
+    return true;
+}
+
+/**
+ * Lists the moves of one game since its last snapshot or compaction, in
+ * order, e.g. to replay a game
+ * @param id Game ID (save slot)
+ * @param moves [out] Move records, buffered ones included
+ * @return Number of moves, -1 if no journal is open or it cannot be read
+ */
+long MoveJournal::history(uint64_t id, std::vector<JournalRecord>& moves) const
+{
+    std::string bytes;
+    moves.clear();
+    if (fd < 0 || !readAll(bytes)) return -1;
+    bytes += pending;
+    forEachRecord(bytes, [&](const JournalRecord& record, const SaveRecord* saved) {
+        if (record.id != id) return;
+        if (saved) moves.clear();
+        else moves.push_back(record);
+    });
+    return moves.size();
+}
+
+/**
+ * @return True if a journal file is open
+ */
+bool MoveJournal::isOpen() const
+{
+    return fd >= 0;
+}
+
+/**
+ * @return Bytes in the journal file, header included; records still
+ *         buffered are not counted
+ */
+uint64_t MoveJournal::size() const
+{
+    return fileSize;
+}
+
+/**
+ * @return Commits that wrote records since the journal was created
+ */
+uint64_t MoveJournal::getCommits() const
+{
+    return commits;
+}
+
+/**
+ * @return Slots the last open() found moves for but could not load a base
+ *         snapshot of, in ID order; their records are kept in the file
+ *         named by getUnreadablePath()
+ */
+const std::vector<uint64_t>& MoveJournal::getUnreadable() const
+{
+    return unreadable;
+}
+
+/**
+ * @return Copy of the journal the last open() kept for unreadable slots,
+ *         FILE.unreadable.TIME[-N]; empty if every slot was recovered
+ */
+const std::string& MoveJournal::getUnreadablePath() const
+{
+    return unreadablePath;
+}
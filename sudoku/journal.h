@@ -0,0 +1,100 @@
+#ifndef JOURNAL_H
+#define JOURNAL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "savestore.h"
+
+const uint32_t JOURNAL_MAGIC = 0x4A4B4453;      // "SDKJ"
+const uint16_t JOURNAL_VERSION = 1;
+
+// What a journal record does to the game in its slot
+enum JournalOp : uint8_t {
+    JOURNAL_SNAPSHOT = 1,                        // Whole game follows as one SaveRecord
+    JOURNAL_PLACE,                               // Correct digit placed and fixed (updateBoard)
+    JOURNAL_HINT,                                // Digit revealed by a hint
+    JOURNAL_WRONG                                // Wrong attempt
+};
+
+// One move in 16 bytes. Counters are stored as their value after the move,
+// not as increments, so replaying a record onto a game that already has it
+// changes nothing.
+struct JournalRecord {
+    uint64_t id;                                 // Game ID (save slot)
+    uint8_t op;                                  // JournalOp
+    uint8_t cell;                                // Cell index (0-80), 0xFF if none
+    uint8_t digit;                               // Digit placed or tried
+    uint8_t count;                               // Hints used (HINT) or wrong attempts (WRONG) after the move
+    uint32_t checksum;                           // FNV-1a of every byte before it
+};
+
+static_assert(sizeof(JournalRecord) == 16, "JournalRecord layout is part of the file format");
+
+// Journal file header, followed by records; a JOURNAL_SNAPSHOT record is
+// followed by the game's SaveRecord
+struct JournalHeader {
+    uint32_t magic;                              // JOURNAL_MAGIC
+    uint16_t version;
+    uint16_t recordSize;                         // sizeof(JournalRecord)
+    uint8_t reserved[8];
+};
+
+static_assert(sizeof(JournalHeader) == 16, "JournalHeader layout is part of the file format");
+
+void applyJournalRecord(const JournalRecord& record, GameData& game); // Replays one move record
+
+// Append-only move journal in front of a SaveStore. Games journaled under a
+// save slot append one record per move; records are buffered and commit()
+// writes every buffered record with one write and one fdatasync, so a
+// server commits all moves of an event-loop pass at once (group commit).
+// The store is only written by compact(): until then the latest state of
+// every changed slot is kept in memory (load() sees it), and the journal
+// holds a base for it, so an in-place store write torn by a crash never
+// loses a game. compact() first replaces the journal atomically with one
+// snapshot per changed slot, then writes and syncs those slots in the
+// store; open() replays a journal left by a crash the same way.
+// Not thread-safe.
+class MoveJournal {
+private:
+    SaveStore& store;                            // Slots, written and synced on compaction
+    int fd;
+    std::string path;                            // Journal file, replaced on compaction
+    std::string pending;                         // Encoded records not yet written
+    std::unordered_map<uint64_t, uint32_t> tickets; // Ticket of the game each ID is journaled for
+    std::unordered_map<uint64_t, GameData> dirty; // Latest state of slots changed since the last compaction
+    std::vector<uint64_t> unreadable;            // Slots open() could not recover
+    std::string unreadablePath;                  // Where open() kept the journal holding them
+    uint32_t nextTicket;
+    uint64_t fileSize;                           // Bytes in the journal file
+    uint64_t commits;
+
+    void push(const JournalRecord& record);      // Stamps the checksum and buffers a record
+    void pushSnapshot(uint64_t id, const GameData& game); // Buffers a snapshot record and its SaveRecord
+    bool readAll(std::string& bytes) const;      // Reads the records in the file
+    bool rewrite();                              // Atomically replaces the file with snapshots of dirty slots
+
+public:
+    explicit MoveJournal(SaveStore& snapshots);
+    ~MoveJournal();
+    MoveJournal(const MoveJournal&) = delete;
+    MoveJournal& operator=(const MoveJournal&) = delete;
+
+    long open(const char* file);                 // Opens or creates, replaying leftover records; -1 on failure
+    void close();                                // Compacts and closes
+    uint32_t snapshot(uint64_t id, const GameData& game); // Starts journaling a game under id, 0 on failure
+    bool append(uint64_t id, uint32_t ticket, JournalOp op, int cell, int digit, const GameData& game); // Buffers a move, false if id was taken over
+    bool commit();                               // Writes buffered records with one fdatasync
+    bool compact();                              // Moves changed slots into the store and empties the journal
+    bool load(uint64_t id, GameData& game) const; // Latest state of a slot, journaled moves included
+    long history(uint64_t id, std::vector<JournalRecord>& moves) const; // Moves since the last snapshot of id, -1 on read failure
+    bool isOpen() const;
+    uint64_t size() const;                       // Bytes in the journal file, buffered records excluded
+    uint64_t getCommits() const;                 // Group commits so far
+    const std::vector<uint64_t>& getUnreadable() const; // Slots whose journaled moves had no readable base
+    const std::string& getUnreadablePath() const; // Copy of the journal kept for those slots, empty if none
+};
+
+#endif
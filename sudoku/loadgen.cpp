@@ -0,0 +1,428 @@
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include "board.h"
+#include "rng.h"
+using namespace std;
+
+typedef chrono::steady_clock Clock;
+
+static const int READ_BUFFER = 4096;
+static const int MAX_EVENTS = 256;
+
+struct LoadOptions {
+    const char* unixPath = nullptr;              // Unix socket path, or
+    int port = 0;                                // loopback TCP port
+    int connections = 100;
+    int sessions = 10;                           // Games per connection
+    double seconds = 5;                          // Length of the move phase
+    uint64_t seed = 1;
+};
+
+// Request kinds a connection can have in flight
+enum RequestType {
+    REQ_NEW,
+    REQ_MOVE,
+    REQ_CLOSE
+};
+
+// A game as the client sees it: only the digits the server accepted
+struct ClientSession {
+    uint64_t id;
+    Board board;
+};
+
+// One server connection with exactly one request in flight
+struct ClientConnection {
+    int fd;
+    vector<ClientSession> sessions;
+    int created;                                 // Sessions opened so far
+    int next;                                    // Round-robin session for the next move
+    RequestType pending;
+    int pendingSession;
+    int pendingCell;
+    int pendingNum;
+    Clock::time_point sentAt;
+    int inLength;
+    char in[READ_BUFFER];
+};
+
+// Latency samples and move outcomes
+struct LoadTotals {
+    vector<uint32_t> newLatency;                 // Nanoseconds
+    vector<uint32_t> moveLatency;
+    long results[8] = {};                        // Indexed like MoveResult in sudoku.h
+    long errors = 0;
+};
+
+static const char* RESULT_NAMES[] = { "correct", "solved", "fixed", "conflict", "wrong", "gameover", "range" };
+static const int RESULT_COUNT = sizeof(RESULT_NAMES) / sizeof(RESULT_NAMES[0]);
+
+/**
+ * Connects to the server and switches the socket to non-blocking
+ * @param options Unix path or TCP port
+ * @return Socket, -1 on failure
+ */
+static int connectServer(const LoadOptions& options)
+{
+    int fd;
+    if (options.unixPath)
+    {
+        sockaddr_un addr;
+        memset(&addr, 0, sizeof(addr));
+        addr.sun_family = AF_UNIX;
+        strncpy(addr.sun_path, options.unixPath, sizeof(addr.sun_path) - 1);
+        fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (fd < 0 || connect(fd, (sockaddr*)&addr, sizeof(addr)) < 0) return -1;
+    }
+    else
+    {
+        sockaddr_in addr;
+        memset(&addr, 0, sizeof(addr));
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(options.port);
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (fd < 0 || connect(fd, (sockaddr*)&addr, sizeof(addr)) < 0) return -1;
+        int on = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+    }
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+    return fd;
+}
+
+/**
+ * Sends one request; with one request in flight the socket buffer always
+ * has room, so a short write counts as a failure
+ * @param conn Connection
+ * @param text Request line including the newline
+ * @param length Bytes in text
+ * @return False if the request could not be sent
+ */
+static bool sendRequest(ClientConnection& conn, const char* text, int length)
+{
+    conn.sentAt = Clock::now();
+    return send(conn.fd, text, length, MSG_NOSIGNAL) == length;
+}
+
+/**
+ * Opens a game in session slot k
+ */
+static bool sendNew(ClientConnection& conn, int k)
+{
+    conn.pending = REQ_NEW;
+    conn.pendingSession = k;
+    return sendRequest(conn, "NEW\n", 4);
+}
+
+/**
+ * Closes the game in session slot k so it can be replaced
+ */
+static bool sendClose(ClientConnection& conn, int k)
+{
+    char text[64];
+    int length = snprintf(text, sizeof(text), "CLOSE %llu\n", (unsigned long long)conn.sessions[k].id);
+    conn.pending = REQ_CLOSE;
+    conn.pendingSession = k;
+    return sendRequest(conn, text, length);
+}
+
+/**
+ * Plays a random candidate in a random empty cell of the next session,
+ * like a player who never breaks the rules but can guess wrong
+ * @param conn Connection
+ * @param rng Random source
+ * @return False if the request could not be sent
+ */
+static bool sendMove(ClientConnection& conn, Xoshiro256& rng)
+{
+    int k = conn.next;
+    conn.next = (conn.next + 1) % (int)conn.sessions.size();
+    const Board& board = conn.sessions[k].board;
+
+    int start = rng.below(81);
+    for (int i = 0; i < 81; i++)
+    {
+        int cell = (start + i) % 81;
+        uint16_t cand = board.get(cell) ? 0 : board.candidates(cell);
+        if (!cand) continue;
+        for (int skip = rng.below(__builtin_popcount(cand)); skip > 0; skip--) cand &= cand - 1;
+
+        char text[64];
+        conn.pending = REQ_MOVE;
+        conn.pendingSession = k;
+        conn.pendingCell = cell;
+        conn.pendingNum = __builtin_ctz(cand) + 1;
+        int length = snprintf(text, sizeof(text), "MOVE %llu %d %d %d\n", (unsigned long long)conn.sessions[k].id,
+                              cell / 9 + 1, cell % 9 + 1, conn.pendingNum);
+        return sendRequest(conn, text, length);
+    }
+    return sendClose(conn, k);                   // Nothing left to try: start over
+}
+
+/**
+ * Handles one response line and sends the connection's next request
+ * @param conn Connection
+ * @param line Response without the newline
+ * @param moving True once every session is open and the move phase runs
+ * @param rng Random source
+ * @param totals [in,out] Latencies and outcome counts
+ * @return False if the connection should stop
+ */
+static bool handleResponse(ClientConnection& conn, const char* line, bool moving, Xoshiro256& rng, LoadTotals& totals)
+{
+    uint32_t ns = (uint32_t)min<long long>(chrono::duration_cast<chrono::nanoseconds>(Clock::now() - conn.sentAt).count(), UINT32_MAX);
+    if (strncmp(line, "OK", 2) != 0)
+    {
+        totals.errors++;
+        return false;
+    }
+
+    int k = conn.pendingSession;
+    if (conn.pending == REQ_NEW)
+    {
+        totals.newLatency.push_back(ns);
+        char* p;
+        ClientSession& session = conn.sessions[k];
+        session.id = strtoull(line + 3, &p, 10);
+        if (strlen(p) < 82) return false;
+        uint8_t cells[81];
+        for (int cell = 0; cell < 81; cell++)
+        {
+            cells[cell] = p[1 + cell] - '0';
+        }
+        session.board.clear();
+        session.board.load(cells);
+        if (conn.created < (int)conn.sessions.size()) conn.created++;
+    }
+    else if (conn.pending == REQ_CLOSE)
+    {
+        return sendNew(conn, k);
+    }
+    else
+    {
+        totals.moveLatency.push_back(ns);
+        for (int r = 0; r < RESULT_COUNT; r++)
+        {
+            if (strcmp(line + 3, RESULT_NAMES[r]) != 0) continue;
+            totals.results[r]++;
+            if (r == 0) conn.sessions[k].board.set(conn.pendingCell, conn.pendingNum);
+            if (r == 1 || r == 5) return sendClose(conn, k);
+            break;
+        }
+    }
+
+    if (conn.created < (int)conn.sessions.size()) return sendNew(conn, conn.created);
+    return moving ? sendMove(conn, rng) : true;
+}
+
+/**
+ * Reads available responses from one connection
+ * @return False if the connection failed or was closed
+ */
+static bool readResponses(ClientConnection& conn, bool moving, Xoshiro256& rng, LoadTotals& totals)
+{
+    while (true)
+    {
+        ssize_t n = read(conn.fd, conn.in + conn.inLength, READ_BUFFER - conn.inLength);
+        if (n == 0) return false;
+        if (n < 0) return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+        conn.inLength += n;
+
+        char* start = conn.in;
+        char* end = conn.in + conn.inLength;
+        char* newline;
+        while ((newline = (char*)memchr(start, '\n', end - start)) != nullptr)
+        {
+            *newline = '\0';
+            if (!handleResponse(conn, start, moving, rng, totals)) return false;
+            start = newline + 1;
+        }
+        conn.inLength = end - start;
+        memmove(conn.in, start, conn.inLength);
+    }
+}
+
+/**
+ * Runs the event loop until the deadline, or during setup until every
+ * connection has opened all its games
+ * @param epollFd Epoll instance holding every connection
+ * @param deadline Stop time
+ * @param moving Keep sending moves after each response
+ * @param conns Connections
+ * @param rng Random source
+ * @param totals [in,out] Latencies and outcomes
+ * @return False if a connection failed
+ */
+static bool runLoop(int epollFd, Clock::time_point deadline, bool moving, vector<ClientConnection>& conns,
+                    Xoshiro256& rng, LoadTotals& totals)
+{
+    epoll_event events[MAX_EVENTS];
+    while (Clock::now() < deadline)
+    {
+        if (!moving)
+        {
+            bool ready = true;
+            for (const ClientConnection& conn : conns)
+            {
+                ready &= conn.created == (int)conn.sessions.size();
+            }
+            if (ready) return true;
+        }
+        int n = epoll_wait(epollFd, events, MAX_EVENTS, 100);
+        for (int i = 0; i < n; i++)
+        {
+            ClientConnection& conn = conns[events[i].data.u32];
+            if (!readResponses(conn, moving, rng, totals)) return false;
+        }
+    }
+    return moving;
+}
+
+/**
+ * Prints latency percentiles of one request kind
+ * @param name Request kind
+ * @param samples Latencies in nanoseconds (sorted in place)
+ */
+static void printLatency(const char* name, vector<uint32_t>& samples)
+{
+    if (samples.empty()) return;
+    sort(samples.begin(), samples.end());
+    auto at = [&](double q) { return samples[min(samples.size() - 1, (size_t)(q * samples.size()))] / 1000.0; };
+    printf("%-5s latency (us): p50 %.1f  p90 %.1f  p99 %.1f  p99.9 %.1f  max %.1f  (%zu requests)\n",
+           name, at(0.5), at(0.9), at(0.99), at(0.999), samples.back() / 1000.0, samples.size());
+}
+
+/**
+ * Prints command-line usage
+ */
+static void printUsage()
+{
+    cerr << "Usage: sudoku-load (-u SOCKET | -p PORT) [-c CONNECTIONS] [-s SESSIONS] [-d SECONDS] [--seed N]\n"
+         << "  -c CONNECTIONS  connections to open (default 100)\n"
+         << "  -s SESSIONS     games per connection (default 10)\n"
+         << "  -d SECONDS      length of the move phase (default 5)\n"
+         << "Opens every game, then keeps one request in flight per connection,\n"
+         << "playing random legal digits round-robin over its games; solved and\n"
+         << "lost games are closed and replaced.\n";
+}
+
+/**
+ * Load generator entry point
+ */
+int main(int argc, char* argv[])
+{
+    LoadOptions options;
+    for (int i = 1; i < argc; i++)
+    {
+        bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "-u") == 0 && hasValue) options.unixPath = argv[++i];
+        else if (strcmp(argv[i], "-p") == 0 && hasValue) options.port = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-c") == 0 && hasValue) options.connections = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-s") == 0 && hasValue) options.sessions = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-d") == 0 && hasValue) options.seconds = atof(argv[++i]);
+        else if (strcmp(argv[i], "--seed") == 0 && hasValue) options.seed = strtoull(argv[++i], nullptr, 10);
+        else
+        {
+            printUsage();
+            return 1;
+        }
+    }
+    if ((!options.unixPath && options.port <= 0) || options.connections < 1 || options.sessions < 1)
+    {
+        printUsage();
+        return 1;
+    }
+
+    Xoshiro256 rng(options.seed);
+    LoadTotals totals;
+    int epollFd = epoll_create1(EPOLL_CLOEXEC);
+    vector<ClientConnection> conns(options.connections);
+    for (int i = 0; i < options.connections; i++)
+    {
+        ClientConnection& conn = conns[i];
+        conn.fd = connectServer(options);
+        if (conn.fd < 0)
+        {
+            perror("connect");
+            return 1;
+        }
+        conn.sessions.resize(options.sessions);
+        conn.created = 0;
+        conn.next = 0;
+        conn.inLength = 0;
+        epoll_event event;
+        event.events = EPOLLIN;
+        event.data.u32 = i;
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, conn.fd, &event);
+    }
+
+    // Setup: every connection opens its games one request at a time
+    auto start = Clock::now();
+    for (ClientConnection& conn : conns)
+    {
+        if (!sendNew(conn, 0))
+        {
+            perror("send");
+            return 1;
+        }
+    }
+    if (!runLoop(epollFd, Clock::time_point::max(), false, conns, rng, totals))
+    {
+        cerr << "Error: Session setup failed (" << totals.errors << " error responses; is the arena large enough?)\n";
+        return 1;
+    }
+    double setupSeconds = chrono::duration<double>(Clock::now() - start).count();
+    long sessions = (long)options.connections * options.sessions;
+    printf("%ld sessions on %d connections opened in %.2f s (%.0f new/s)\n", sessions, options.connections,
+           setupSeconds, sessions / setupSeconds);
+    printLatency("new", totals.newLatency);
+
+    // Move phase
+    totals.newLatency.clear();
+    start = Clock::now();
+    for (ClientConnection& conn : conns)
+    {
+        if (!sendMove(conn, rng))
+        {
+            perror("send");
+            return 1;
+        }
+    }
+    if (!runLoop(epollFd, start + chrono::duration_cast<Clock::duration>(chrono::duration<double>(options.seconds)),
+                 true, conns, rng, totals))
+    {
+        cerr << "Error: Connection failed during the move phase (" << totals.errors << " error responses)\n";
+        return 1;
+    }
+    double seconds = chrono::duration<double>(Clock::now() - start).count();
+    printf("%zu moves in %.2f s (%.0f moves/s)\n", totals.moveLatency.size(), seconds, totals.moveLatency.size() / seconds);
+    printLatency("move", totals.moveLatency);
+    printLatency("new", totals.newLatency);
+    printf("results:");
+    for (int r = 0; r < RESULT_COUNT; r++)
+    {
+        if (totals.results[r]) printf(" %s %ld", RESULT_NAMES[r], totals.results[r]);
+    }
+    printf("\n");
+
+    for (ClientConnection& conn : conns)
+    {
+        close(conn.fd);
+    }
+    close(epollFd);
+    return 0;
+}
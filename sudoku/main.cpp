@@ -1,6 +1,9 @@
 #include <iostream>
 #include <limits>
+#include <string>
+#include <unistd.h>
 #include "sudoku.h"
+#include "render.h"
 using namespace std;
 
 #define FG_RED     "\033[31m"
@@ -58,11 +61,14 @@ bool handleQuitOption()
 int main() 
 {
     bool playAgain = true;
+    PuzzlePool pool(4, 1);  // Prepares the next games while this one is played
+    BoardRenderer renderer;
     
     // Main game loop - continues until player chooses not to play again
     while (playAgain) 
     {
-        SudokuGame game;  // Initialize new game instance
+        PooledPuzzle pooled;
+        SudokuGame game = pool.takeAny(pooled) ? SudokuGame(pooled) : SudokuGame();  // Initialize new game instance
         
         // Display game introduction and rules
         cout << FG_YELLOW << BOLD << "\n                                   OH! So You Think You Good With Numbers AY!! Lets's See If You Live Upto Your Confidence" << RESET;
@@ -71,15 +77,21 @@ int main()
                   <<"                                                         1. Correct numbers become permanent\n"
                   <<"                                                         2. You get 2 hints\n"
                   <<"                                                         3. 3 wrong attempts end the game\n"
-                  <<"                                                         4. Press 'q' or 'Q' to quit game\n\n" << RESET;
+                  <<"                                                         4. Press 'q' or 'Q' to quit game\n"
+                  <<"                                                         5. 'u' undoes and 'r' redoes a move; 'm NAME' marks a\n"
+                  <<"                                                            what-if branch point and 'g NAME' goes back to it\n\n" << RESET;
+        cout << FG_CYAN << "                                                                  Difficulty: " << difficultyName(game.getDifficulty()) << "\n\n" << RESET;
         
         bool shouldExit = false;  // Flag to control game exit
         while (!shouldExit) 
         {
-            game.printBoard();  // Display current board state
+            // Display current board state: one buffered frame, one write
+            cout.flush();
+            renderer.renderFrame(game);
+            renderer.writeTo(STDOUT_FILENO);
 
             int row, col, num;
-            cout << FG_YELLOW << BOLD << "Enter row (1-9), column (1-9), number (1-9) [e.g. Format: 1 2 3] / Press 0 0 0 for a hint / 'q' to quit: " << RESET;
+            cout << FG_YELLOW << BOLD << "Enter row (1-9), column (1-9), number (1-9) [e.g. Format: 1 2 3] / Press 0 0 0 for a hint / 'u' 'r' 'm NAME' 'g NAME' / 'q' to quit: " << RESET;
             
             // Check for quit command first
             char firstInput;
@@ -101,6 +113,48 @@ int main()
                 continue;
             }
             
+            // Undo and redo replay the move history; no move is re-checked
+            if (firstInput == 'u' || firstInput == 'U' || firstInput == 'r' || firstInput == 'R') 
+            {
+                clearInputBuffer();
+                bool undo = firstInput == 'u' || firstInput == 'U';
+                if (undo ? game.undo() : game.redo()) 
+                {
+                    cout << FG_CYAN << "\n\n                                                                    " << (undo ? "Undone" : "Redone")
+                         << " (" << game.getUndoDepth() << " to undo, " << game.getRedoDepth() << " to redo)\n\n" << RESET;
+                } 
+                else 
+                {
+                    cout << FG_RED << "\n\n                                                                    Nothing to " << (undo ? "undo" : "redo") << "!\n\n" << RESET;
+                }
+                continue;
+            }
+
+            // What-if branch points: mark the position, try moves, go back
+            if (firstInput == 'm' || firstInput == 'M' || firstInput == 'g' || firstInput == 'G') 
+            {
+                string name;
+                cin >> name;
+                clearInputBuffer();
+                if ((firstInput == 'm' || firstInput == 'M') && game.markBranch(name)) 
+                {
+                    cout << FG_CYAN << "\n\n                                                                    Branch point '" << name << "' marked\n\n" << RESET;
+                } 
+                else if (firstInput == 'm' || firstInput == 'M') 
+                {
+                    cout << FG_RED << "\n\n                                                                    Too many branch points!\n\n" << RESET;
+                } 
+                else if (game.restoreBranch(name)) 
+                {
+                    cout << FG_CYAN << "\n\n                                                                    Back at branch point '" << name << "'\n\n" << RESET;
+                } 
+                else 
+                {
+                    cout << FG_RED << "\n\n                                                                    No branch point named '" << name << "'!\n\n" << RESET;
+                }
+                continue;
+            }
+            
             // Put the character back if it wasn't a quit command
             cin.putback(firstInput);
             
@@ -115,76 +169,73 @@ int main()
             // Handle hint request
             if (row == 0 && col == 0 && num == 0) 
             {
-                if (game.getHintsUsed() < 2) 
+                Hint hint;
+                if (game.provideHint(hint)) 
                 {
-                    game.provideHint();
+                    renderHint(cout, hint);
                 } 
-                else 
+                else if (game.getHintsUsed() >= MAX_HINTS) 
                 {
                     cout << FG_RED << "\n\n                                                                    No hints left!\n\n" << RESET;
                 }
                 continue;
             }
 
-            // Validate input range
-            if (row < 1 || row > 9 || col < 1 || col > 9 || num < 1 || num > 9) 
-            {
-                cout << FG_RED << "\n\n                                                                      Numbers must be 1-9!\n\n" << RESET;
-                continue; 
-            }
-            
-            // Handle save/load commands (hidden features)
+            // Handle save/load commands (hidden features); checked before the
+            // range check, which would reject them
             if (row == -1 && col == -1 && num == -1) 
             {
-                game.saveGame("sudoku_save.txt");
+                if (game.saveGame("sudoku_save.dat")) cout << "Game saved to sudoku_save.dat\n";
+                else cout << "Error: Could not save game!\n";
                 continue;
             }
             else if (row == -2 && col == -2 && num == -2) 
             {
-                game.loadGame("sudoku_save.txt");
+                if (game.loadGame("sudoku_save.dat")) cout << "Game loaded from sudoku_save.dat\n";
+                else cout << "Error: Could not load game!\n";
                 continue;
             }
 
-            // Check if cell is already fixed (correct)
-            if (game.isFixed(row-1, col-1)) 
+            // Validate input range
+            if (row < 1 || row > 9 || col < 1 || col > 9 || num < 1 || num > 9) 
+            {
+                cout << FG_RED << "\n\n                                                                      Numbers must be 1-9!\n\n" << RESET;
+                continue; 
+            }
+            
+            // Apply the move and report its outcome
+            MoveResult result = game.makeMove(row, col, num);
+            if (result == MOVE_FIXED) 
             {
                 cout << FG_GREEN << "\n\n                                                     Cell (" << row << "," << col << ") is already correct!\n\n" << RESET;
-                continue;
             }
-
-            // Validate move against Sudoku rules
-            if (!game.isValid(row-1, col-1, num)) 
+            else if (result == MOVE_CONFLICT) 
             {
                 cout << FG_RED << "\n\n                                                           Invalid move! Number conflicts with existing numbers.\n\n" << RESET;
-                continue;
             }
-
-            // Check if number matches solution
-            if (num != game.getSolutionAt(row-1, col-1)) 
+            else if (result == MOVE_WRONG || result == MOVE_GAME_OVER) 
             {
-                game.incrementWrongAttempts();
-                int attemptsLeft = 3 - game.getWrongAttempts();
+                int attemptsLeft = MAX_WRONG_ATTEMPTS - game.getWrongAttempts();
                 cout << FG_RED << BOLD << "\n\n                                                           Wrong! Attempts left: " << attemptsLeft << "\n\n" << RESET;
                 
                 // Game over condition
-                if (game.getWrongAttempts() >= 3) 
+                if (result == MOVE_GAME_OVER) 
                 {
                     cout << FG_RED << "\n\n                                                                    Game Over! Good Luck Next Time\n\n" << RESET;
-                    game.revealSolution();
+                    renderSolution(cout, game);
                     break;       
                 }
-                continue;
             }
-
-            // Valid move - update board
-            game.updateBoard(row-1, col-1, num);
-            cout << FG_GREEN << "\n\n                                                                         Correct!\n\n" << RESET;
-
-            // Check for win condition
-            if (game.isComplete()) 
+            else 
             {
-                cout << FG_GREEN << "\n\n                                                           Congratulations! You solved the Sudoku!\n\n" << RESET;
-                break;
+                cout << FG_GREEN << "\n\n                                                                         Correct!\n\n" << RESET;
+
+                // Check for win condition
+                if (result == MOVE_SOLVED) 
+                {
+                    cout << FG_GREEN << "\n\n                                                           Congratulations! You solved the Sudoku!\n\n" << RESET;
+                    break;
+                }
             }
         }
 
@@ -0,0 +1,152 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <algorithm>
+#include <array>
+#include <climits>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "grid.h"
+#include "thread_pool.h"
+
+// Solves or counts one puzzle on every worker of a ThreadPool. The calling
+// thread splits the search tree breadth-first (propagate, then branch on
+// the most constrained cell) until there are TASKS_PER_WORKER subtrees per
+// worker, and submits each subtree as a task. Uneven subtrees are balanced
+// by the pool's work stealing: a worker that runs out of subtrees takes
+// queued ones from the others. All workers share one SearchControl, so the
+// first solution (solve) or the count limit (enumeration) stops every
+// subtree at its next node. Each worker keeps its own GridSolver, of the
+// same rule set.
+template <int BOX, typename Rules = ClassicRules<BOX> >
+class ParallelSolver {
+public:
+    typedef GridTraits<BOX> T;
+    typedef std::array<uint8_t, T::CELLS> Grid;
+
+    static const int TASKS_PER_WORKER = 16;
+    static const int MAX_SPLIT_DEPTH = 24;       // Levels split before giving up on more subtrees
+
+private:
+    ThreadPool& pool;
+    GridSolver<BOX, Rules> splitter;             // Used by the calling thread only
+    std::vector<std::unique_ptr<GridSolver<BOX, Rules> > > solvers;  // One per worker
+    std::mutex solutionLock;
+
+public:
+    explicit ParallelSolver(ThreadPool& workers);
+    long countSolutions(const uint8_t puzzle[], long limit, uint8_t solution[], SolverStats* stats = nullptr);
+    bool solve(const uint8_t puzzle[], uint8_t solution[]);  // First solution any worker finds
+};
+
+/**
+ * ParallelSolver constructor
+ * @param workers Pool whose workers run the subtrees
+ */
+template <int BOX, typename Rules>
+ParallelSolver<BOX, Rules>::ParallelSolver(ThreadPool& workers) : pool(workers)
+{
+    for (int i = 0; i < pool.size(); i++)
+    {
+        solvers.emplace_back(new GridSolver<BOX, Rules>());
+    }
+}
+
+/**
+ * Counts solutions across the pool, stopping every worker once limit
+ * solutions were found. Blocks until the search is over.
+ * @param puzzle T::CELLS digits in row-major order, 0 for empty cells
+ * @param limit Maximum number of solutions to look for
+ * @param solution [out] One of the solutions found (which one depends on
+ *        scheduling), if any
+ * @param stats [in,out] Adds the workers' counters, if not nullptr
+ * @return Number of solutions found (at most limit)
+ */
+template <int BOX, typename Rules>
+long ParallelSolver<BOX, Rules>::countSolutions(const uint8_t puzzle[], long limit, uint8_t solution[], SolverStats* stats)
+{
+    SearchControl control;
+    control.stop = false;
+    control.found = 0;
+    control.limit = limit;
+    bool haveSolution = false;
+
+    // Split breadth-first on this thread; frontier holds unexpanded subtrees
+    std::vector<Grid> frontier(1), next;
+    memcpy(frontier[0].data(), puzzle, T::CELLS);
+    if (!splitter.load(puzzle)) frontier.clear();
+    size_t target = (size_t)pool.size() * TASKS_PER_WORKER;
+    for (int depth = 0; depth < MAX_SPLIT_DEPTH && !frontier.empty() && frontier.size() < target; depth++)
+    {
+        next.clear();
+        for (Grid& grid : frontier)
+        {
+            int cell = 0;
+            typename T::Mask digits = 0;
+            splitter.load(grid.data());
+            SplitResult result = splitter.split(grid.data(), cell, digits);
+            if (result == SPLIT_SOLVED && control.found++ < limit && !haveSolution)
+            {
+                memcpy(solution, grid.data(), T::CELLS);
+                haveSolution = true;
+            }
+            if (result != SPLIT_BRANCH) continue;
+            for (; digits; digits &= digits - 1)
+            {
+                next.push_back(grid);
+                next.back()[cell] = __builtin_ctz(digits) + 1;
+            }
+        }
+        frontier.swap(next);
+        if (control.found >= limit) frontier.clear();
+    }
+
+    for (const Grid& grid : frontier)
+    {
+        const Grid* subtree = &grid;
+        pool.submit([this, subtree, &control, &haveSolution, solution, limit](int worker) {
+            if (control.stop.load(std::memory_order_relaxed)) return;
+            GridSolver<BOX, Rules>& solver = *solvers[worker];
+            solver.load(subtree->data());
+            solver.setControl(&control);
+            int count = solver.countSolutions((int)std::min<long>(limit, INT_MAX));
+            solver.setControl(nullptr);
+            if (count == 0) return;
+            std::lock_guard<std::mutex> guard(solutionLock);
+            if (!haveSolution) solver.getSolution(solution);
+            haveSolution = true;
+        });
+    }
+    pool.wait();
+
+    if (stats)
+    {
+        addStats(*stats, splitter.getStats());
+        for (auto& solver : solvers)
+        {
+            addStats(*stats, solver->getStats());
+        }
+    }
+    splitter.resetStats();
+    for (auto& solver : solvers)
+    {
+        solver->resetStats();
+    }
+    return std::min<long>(control.found.load(), limit);
+}
+
+/**
+ * Finds a solution across the pool; the first worker to find one stops
+ * the others
+ * @param puzzle T::CELLS digits in row-major order, 0 for empty cells
+ * @param solution [out] The solution found
+ * @return False if the puzzle has no solution
+ */
+template <int BOX, typename Rules>
+bool ParallelSolver<BOX, Rules>::solve(const uint8_t puzzle[], uint8_t solution[])
+{
+    return countSolutions(puzzle, 1, solution) == 1;
+}
+
+#endif
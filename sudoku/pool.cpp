@@ -0,0 +1,266 @@
+#include "pool.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include "canonical.h"
+#include "generator.h"
+#include "solver.h"
+
+// After giving up on rare tiers, a refill thread still makes a short burst
+// of puzzles this often, so a starved tier (expert, evil) keeps filling
+// slowly instead of waiting for another tier to drain
+static const std::chrono::milliseconds STARVED_RETRY(1000);
+static const long STARVED_BURST = 64;
+
+/**
+ * PuzzlePool constructor - Creates the tiers and starts the refill threads
+ * @param capacity Puzzles kept ready per tier (rounded up to a power of two)
+ * @param threadCount Refill threads; 0 for a pool filled only by add and loadFile
+ * @param seed Seed for the puzzle seeds, 0 for a fresh random one
+ */
+PuzzlePool::PuzzlePool(size_t capacity, int threadCount, uint64_t seed)
+    : stopping(false), nextTier(0), generated(0), discarded(0), wakeups(0)
+{
+    for (int d = 0; d < DIFFICULTY_COUNT; d++)
+    {
+        tiers[d].reset(new BoundedQueue<PooledPuzzle>(capacity));
+    }
+    if (seed == 0)
+    {
+        std::random_device device;
+        seed = ((uint64_t)device() << 32) ^ device() ^ (uint64_t)std::chrono::steady_clock::now().time_since_epoch().count();
+    }
+    Xoshiro256 seeds(seed);
+    for (int i = 0; i < threadCount; i++)
+    {
+        threads.emplace_back(&PuzzlePool::run, this, seeds.next());
+    }
+}
+
+/**
+ * PuzzlePool destructor - Stops and joins the refill threads
+ */
+PuzzlePool::~PuzzlePool()
+{
+    {
+        std::lock_guard<std::mutex> guard(idleLock);
+        stopping = true;
+    }
+    refill.notify_all();
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+}
+
+/**
+ * @return True if any tier has room
+ */
+bool PuzzlePool::needsRefill() const
+{
+    for (int d = 0; d < DIFFICULTY_COUNT; d++)
+    {
+        if (tiers[d]->size() < tiers[d]->capacity()) return true;
+    }
+    return false;
+}
+
+/**
+ * Wakes the refill threads once a tier drops below half capacity, so
+ * sleeping threads are not woken on every single take
+ * @param difficulty Tier that was taken from
+ */
+void PuzzlePool::tookFrom(Difficulty difficulty)
+{
+    if (threads.empty() || tiers[difficulty]->size() >= tiers[difficulty]->capacity() / 2) return;
+    std::lock_guard<std::mutex> guard(idleLock);
+    wakeups++;
+    refill.notify_all();
+}
+
+/**
+ * Refill thread: generates and grades games and files them by difficulty.
+ * Grades cannot be chosen up front, so a puzzle for a full tier is dropped;
+ * the thread sleeps when every tier is full, or when the last few tiers'
+ * worth of puzzles were all dropped, until a take drains a tier below half.
+ * In the second case it also wakes every STARVED_RETRY for a burst of
+ * STARVED_BURST puzzles, about 1% of a core, for the tiers still short.
+ * @param seed Seed for this thread's puzzle seeds
+ */
+void PuzzlePool::run(uint64_t seed)
+{
+    Xoshiro256 seeds(seed);
+    PuzzleGenerator generator;
+    PooledPuzzle pooled;
+    const long giveUp = (long)tiers[0]->capacity() * DIFFICULTY_COUNT;
+    long misses = 0;                             // Drops since the last useful puzzle
+    while (!stopping)
+    {
+        if (misses >= giveUp || !needsRefill())
+        {
+            bool starved = needsRefill();        // Gave up on a rare tier, not done
+            std::unique_lock<std::mutex> lock(idleLock);
+            long seen = wakeups;
+            auto woken = [&]() { return stopping || (wakeups != seen && needsRefill()); };
+            if (!starved) refill.wait(lock, woken);
+            else if (!refill.wait_for(lock, STARVED_RETRY, woken))
+            {
+                misses = giveUp - STARVED_BURST;  // Timed retry: one burst, then sleep again
+                continue;
+            }
+            misses = 0;
+            continue;
+        }
+
+        pooled.seed = seeds.next() | 1;          // Never 0, which means unknown
+        generator.reseed(pooled.seed);
+        generator.randomGame(pooled.solution, pooled.puzzle);
+        pooled.difficulty = gradePuzzle(pooled.puzzle).difficulty;
+        generated++;
+        if (tiers[pooled.difficulty]->tryPush(pooled)) misses = 0;
+        else
+        {
+            discarded++;
+            misses++;
+        }
+    }
+}
+
+/**
+ * Takes a ready puzzle of one difficulty
+ * @param difficulty Tier to take from
+ * @param puzzle [out] The puzzle
+ * @return False if the tier is empty; generate synchronously instead
+ */
+bool PuzzlePool::take(Difficulty difficulty, PooledPuzzle& puzzle)
+{
+    if (!tiers[difficulty]->tryPop(puzzle)) return false;
+    tookFrom(difficulty);
+    return true;
+}
+
+/**
+ * Takes a ready puzzle of any difficulty, starting at a different tier
+ * each call so the mix of games matches what refill produces
+ * @param puzzle [out] The puzzle
+ * @return False if every tier is empty
+ */
+bool PuzzlePool::takeAny(PooledPuzzle& puzzle)
+{
+    unsigned first = nextTier.fetch_add(1, std::memory_order_relaxed);
+    for (int i = 0; i < DIFFICULTY_COUNT; i++)
+    {
+        if (take((Difficulty)((first + i) % DIFFICULTY_COUNT), puzzle)) return true;
+    }
+    return false;
+}
+
+/**
+ * Adds a puzzle to its tier
+ * @param puzzle Puzzle with solution and difficulty filled in
+ * @return False if the tier is full
+ */
+bool PuzzlePool::add(const PooledPuzzle& puzzle)
+{
+    return tiers[puzzle.difficulty]->tryPush(puzzle);
+}
+
+/**
+ * Adds puzzles from a pool file: one 81-character puzzle per line ('0' or
+ * '.' for empty cells), optionally followed by its grade and seed, as
+ * written by saveFile or sudoku-gen --grade. Ungraded puzzles are graded;
+ * every puzzle is solved, and lines without exactly one solution are
+ * skipped, as are puzzles equivalent to an earlier line (same puzzle up to
+ * symmetry and relabeling). Puzzles for full tiers are dropped.
+ * @param path Pool file
+ * @return Puzzles added, -1 if the file cannot be read
+ */
+long PuzzlePool::loadFile(const char* path)
+{
+    FILE* in = fopen(path, "r");
+    if (!in) return -1;
+
+    SudokuSolver solver;
+    PuzzleIndex seen;
+    PooledPuzzle pooled;
+    char line[256];
+    long added = 0;
+    while (fgets(line, sizeof(line), in))
+    {
+        if (strlen(line) < 81) continue;
+        bool valid = true;
+        for (int cell = 0; cell < 81 && valid; cell++)
+        {
+            char ch = line[cell] == '.' ? '0' : line[cell];
+            valid = ch >= '0' && ch <= '9';
+            pooled.puzzle[cell] = ch - '0';
+        }
+        if (!valid || !solver.load(pooled.puzzle) || solver.countSolutions(2) != 1) continue;
+        if (!seen.insertPuzzle(pooled.puzzle)) continue;
+        solver.getSolution(pooled.solution);
+
+        char grade[16] = "";
+        unsigned long long seed = 0;
+        sscanf(line + 81, "%15s %llu", grade, &seed);
+        pooled.seed = seed;
+        if (!parseDifficulty(grade, pooled.difficulty)) pooled.difficulty = gradePuzzle(pooled.puzzle).difficulty;
+        added += add(pooled);
+    }
+    fclose(in);
+    return added;
+}
+
+/**
+ * Drains every tier into a pool file that loadFile reads back
+ * @param path Pool file, overwritten
+ * @return Puzzles written, -1 if the file cannot be written
+ */
+long PuzzlePool::saveFile(const char* path)
+{
+    FILE* out = fopen(path, "w");
+    if (!out) return -1;
+
+    PooledPuzzle pooled;
+    char text[82];
+    long written = 0;
+    for (int d = 0; d < DIFFICULTY_COUNT; d++)
+    {
+        while (tiers[d]->tryPop(pooled))
+        {
+            for (int cell = 0; cell < 81; cell++)
+            {
+                text[cell] = '0' + pooled.puzzle[cell];
+            }
+            text[81] = '\0';
+            fprintf(out, "%s %s %llu\n", text, difficultyName(pooled.difficulty), (unsigned long long)pooled.seed);
+            written++;
+        }
+    }
+    return fclose(out) == 0 ? written : -1;
+}
+
+/**
+ * @param difficulty Tier
+ * @return Approximate number of ready puzzles in the tier
+ */
+size_t PuzzlePool::available(Difficulty difficulty) const
+{
+    return tiers[difficulty]->size();
+}
+
+/**
+ * @return Puzzles generated by the refill threads so far
+ */
+long PuzzlePool::getGenerated() const
+{
+    return generated.load();
+}
+
+/**
+ * @return Generated puzzles dropped because their tier was full
+ */
+long PuzzlePool::getDiscarded() const
+{
+    return discarded.load();
+}
@@ -0,0 +1,64 @@
+#ifndef POOL_H
+#define POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "bounded_queue.h"
+#include "grader.h"
+
+// A ready-to-play game: givens, solution and the seed that generated it
+struct PooledPuzzle {
+    uint8_t puzzle[81];                          // Givens, 0 for empty cells
+    uint8_t solution[81];
+    uint64_t seed;                               // SudokuGame(seed) rebuilds it; 0 if unknown
+    Difficulty difficulty;
+};
+
+// Pre-generated puzzles per difficulty tier, so starting a game is a queue
+// pop instead of a generate-and-grade run. Each tier is a bounded lock-free
+// ring buffer; background threads generate and grade puzzles and push them
+// to their tier until every tier is full, then sleep until a take drains
+// one below half. Grades come out of generation at very different rates
+// (hard is rare), so a thread also sleeps after a long run of puzzles that
+// all landed on full tiers, rather than spinning for the rare one, and only
+// retries the starved tiers with a short burst about once a second. The pool
+// can be warm-started from, and drained to, a pool file so a restarted
+// process serves games immediately.
+class PuzzlePool {
+private:
+    std::unique_ptr<BoundedQueue<PooledPuzzle> > tiers[DIFFICULTY_COUNT];
+    std::vector<std::thread> threads;
+    std::atomic<bool> stopping;
+    std::atomic<unsigned> nextTier;              // Rotating first tier for takeAny
+    std::atomic<long> generated;                 // Puzzles made by the refill threads
+    std::atomic<long> discarded;                 // Made for a tier that was already full
+    long wakeups;                                // Refill signals sent, guarded by idleLock
+    std::mutex idleLock;
+    std::condition_variable refill;              // Signals a drained tier or shutdown
+
+    bool needsRefill() const;                    // True if any tier is below capacity
+    void tookFrom(Difficulty difficulty);        // Wakes refill threads below half capacity
+    void run(uint64_t seed);                     // Refill thread loop
+
+public:
+    PuzzlePool(size_t capacity, int threadCount, uint64_t seed = 0);
+    ~PuzzlePool();
+    PuzzlePool(const PuzzlePool&) = delete;
+    PuzzlePool& operator=(const PuzzlePool&) = delete;
+
+    bool take(Difficulty difficulty, PooledPuzzle& puzzle); // Ready puzzle of one tier, false if empty
+    bool takeAny(PooledPuzzle& puzzle);          // Ready puzzle of any tier, false if all empty
+    bool add(const PooledPuzzle& puzzle);        // Adds to the puzzle's tier, false if full
+    long loadFile(const char* path);             // Warm start: adds puzzles from a pool file, -1 if unreadable
+    long saveFile(const char* path);             // Drains the pool into a pool file, -1 if unwritable
+    size_t available(Difficulty difficulty) const; // Approximate ready puzzles in a tier
+    long getGenerated() const;                   // Puzzles generated by the refill threads
+    long getDiscarded() const;                   // Generated puzzles dropped on a full tier
+};
+
+#endif
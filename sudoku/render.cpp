@@ -0,0 +1,246 @@
+#include "render.h"
+#include <cerrno>
+#include <cstring>
+#include <unistd.h>
+using namespace std;
+
+#define FG_GREEN   "\033[32m"
+#define FG_CYAN    "\033[36m"
+#define BOLD       "\033[1m"
+#define RESET      "\033[0m"
+
+namespace {
+
+// Frame colors; each code starts with a reset so switching never depends
+// on what was set before
+enum FrameStyle {
+    STYLE_PLAIN,                                 // Digits
+    STYLE_HEADER,                                // Bold cyan row and column numbers
+    STYLE_GRID                                   // Green box lines
+};
+
+const char* const STYLE_CODES[] = { "\033[0m", "\033[0;1;36m", "\033[0;32m" };
+const int STYLE_LENGTHS[] = { 4, 9, 7 };
+
+const char HEADER_LINE[] = "    1 2 3   4 5 6   7 8 9\n";
+const char BORDER_LINE[] = "  +-------+-------+-------+\n";
+
+// Frame line and column of each cell's digit
+inline int cellLine(int cell) { int row = Board::rowOf(cell); return 2 + row + row / 3; }
+inline int cellColumn(int cell) { int col = Board::colOf(cell); return 4 + 2 * col + 2 * (col / 3); }
+
+}
+
+/**
+ * BoardRenderer constructor
+ * @param top Terminal row (1-based) the frame is anchored at, 0 to draw
+ *        inline at the cursor
+ */
+BoardRenderer::BoardRenderer(int top) : length(0), top(top), style(-1), drawn(false)
+{
+    memset(shown, 0, sizeof(shown));
+}
+
+/**
+ * Appends raw bytes to the frame
+ * @param text Bytes to append
+ * @param count Number of bytes
+ */
+void BoardRenderer::append(const char* text, int count)
+{
+    memcpy(buffer + length, text, count);
+    length += count;
+}
+
+/**
+ * Appends a small non-negative decimal number
+ * @param value Number to append
+ */
+void BoardRenderer::appendNumber(int value)
+{
+    char digits[12];
+    int count = 0;
+    do
+    {
+        digits[count++] = '0' + value % 10;
+        value /= 10;
+    } while (value);
+    while (count) buffer[length++] = digits[--count];
+}
+
+/**
+ * Switches the color, emitting an escape sequence only on a change
+ * @param next FrameStyle to use from here on
+ */
+void BoardRenderer::appendStyle(int next)
+{
+    if (next == style) return;
+    append(STYLE_CODES[next], STYLE_LENGTHS[next]);
+    style = next;
+}
+
+/**
+ * Moves the cursor to a position inside an anchored frame
+ * @param line Frame line (0-based)
+ * @param column Frame column (0-based)
+ */
+void BoardRenderer::moveTo(int line, int column)
+{
+    append("\033[", 2);
+    appendNumber(top + line);
+    buffer[length++] = ';';
+    appendNumber(column + 1);
+    buffer[length++] = 'H';
+}
+
+/**
+ * Renders the whole board with row/column headers and 3x3 box boundaries
+ * @param game Game to draw
+ * @return Bytes rendered
+ */
+int BoardRenderer::renderFrame(const SudokuGame& game)
+{
+    length = 0;
+    style = -1;
+    if (top > 0) moveTo(0, 0);
+
+    appendStyle(STYLE_HEADER);
+    append(HEADER_LINE, sizeof(HEADER_LINE) - 1);
+    appendStyle(STYLE_GRID);
+    append(BORDER_LINE, sizeof(BORDER_LINE) - 1);
+    for (int i = 0; i < 9; i++)
+    {
+        if (i % 3 == 0 && i != 0)
+        {
+            appendStyle(STYLE_GRID);
+            append(BORDER_LINE, sizeof(BORDER_LINE) - 1);
+        }
+        appendStyle(STYLE_HEADER);
+        buffer[length++] = '1' + i;
+        appendStyle(STYLE_GRID);
+        append(" | ", 3);
+
+        for (int j = 0; j < 9; j++)
+        {
+            if (j % 3 == 0 && j != 0)
+            {
+                appendStyle(STYLE_GRID);
+                append("| ", 2);
+            }
+            int cell = Board::index(i, j);
+            int value = game.getCell(i, j);
+            shown[cell] = value;
+            appendStyle(STYLE_PLAIN);
+            buffer[length++] = value == 0 ? '.' : '0' + value;
+            buffer[length++] = ' ';
+        }
+        appendStyle(STYLE_GRID);
+        append("|\n", 2);
+    }
+    append(BORDER_LINE, sizeof(BORDER_LINE) - 1);
+    appendStyle(STYLE_PLAIN);
+    drawn = true;
+    return length;
+}
+
+/**
+ * Renders only the cells that changed since the last render, each as a
+ * cursor move plus one digit, then parks the cursor below the frame.
+ * Inline renderers cannot address the screen and redraw the whole board.
+ * @param game Game to draw
+ * @return Bytes rendered, 0 if nothing changed
+ */
+int BoardRenderer::renderChanges(const SudokuGame& game)
+{
+    if (top == 0 || !drawn) return renderFrame(game);
+
+    length = 0;
+    style = STYLE_PLAIN;                         // Every frame ends plain
+    for (int cell = 0; cell < 81; cell++)
+    {
+        int value = game.getCell(Board::rowOf(cell), Board::colOf(cell));
+        if (value == shown[cell]) continue;
+        shown[cell] = value;
+        moveTo(cellLine(cell), cellColumn(cell));
+        buffer[length++] = value == 0 ? '.' : '0' + value;
+    }
+    if (length > 0) moveTo(FRAME_LINES, 0);
+    return length;
+}
+
+/**
+ * Forgets what is on screen, e.g. after the terminal was cleared
+ */
+void BoardRenderer::invalidate()
+{
+    drawn = false;
+}
+
+/**
+ * @return Rendered bytes (not NUL-terminated)
+ */
+const char* BoardRenderer::data() const
+{
+    return buffer;
+}
+
+/**
+ * @return Number of rendered bytes
+ */
+int BoardRenderer::size() const
+{
+    return length;
+}
+
+/**
+ * Writes the rendered bytes; a single write unless the descriptor takes
+ * them in parts
+ * @param fd Destination descriptor
+ * @return False on a write error
+ */
+bool BoardRenderer::writeTo(int fd) const
+{
+    for (int sent = 0; sent < length; )
+    {
+        ssize_t n = write(fd, buffer + sent, length - sent);
+        if (n < 0)
+        {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        sent += n;
+    }
+    return true;
+}
+
+/**
+ * Displays the complete solution with formatting
+ * @param out Destination stream
+ * @param game Game whose solution is shown
+ */
+void renderSolution(ostream& out, const SudokuGame& game)
+{
+    out << "\nSolution:\n";
+    for (int i = 0; i < 9; i++)
+    {
+        for (int j = 0; j < 9; j++)
+        {
+            out << game.getSolutionAt(i, j) << " ";
+            if (j % 3 == 2) out << " ";
+        }
+        out << "\n";
+        if (i % 3 == 2) out << "\n";
+    }
+}
+
+/**
+ * Reports a placed hint and the technique that proves it
+ * @param out Destination stream
+ * @param hint Hint returned by SudokuGame::provideHint
+ */
+void renderHint(ostream& out, const Hint& hint)
+{
+    out << FG_CYAN << "\n\n                                                        Hint placed at (" << Board::rowOf(hint.cell)+1 << "," << Board::colOf(hint.cell)+1 << ")";
+    if (hint.technique != TECH_COUNT) out << " by " << techniqueName(hint.technique);
+    out << "\n\n" << RESET;
+}
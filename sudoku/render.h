@@ -0,0 +1,47 @@
+#ifndef RENDER_H
+#define RENDER_H
+
+#include <cstdint>
+#include <ostream>
+#include "sudoku.h"
+
+// Console rendering of a headless game session. Nothing in libsudoku
+// writes to a stream; the CLI draws through these.
+
+const int FRAME_BYTES = 2048;                    // Upper bound of one rendered frame
+const int FRAME_LINES = 14;                      // Terminal lines a board frame occupies
+
+// Draws the board into a fixed buffer with no allocation and hands it to
+// the terminal in one write. Colors are emitted only where they change.
+// Inline renderers (top = 0) draw at the cursor, like ordinary output.
+// Anchored renderers draw at a fixed terminal row and remember what is on
+// screen, so renderChanges can redraw only the cells that changed by
+// cursor positioning, which keeps spectator and replay feeds small.
+class BoardRenderer {
+private:
+    char buffer[FRAME_BYTES];
+    int length;                                  // Bytes rendered into buffer
+    int top;                                     // Terminal row of the frame (1-based), 0 for inline
+    int style;                                   // Color state at the end of buffer, -1 unknown
+    uint8_t shown[81];                           // Digits on screen after the last render
+    bool drawn;                                  // shown reflects the screen
+
+    void append(const char* text, int count);
+    void appendNumber(int value);
+    void appendStyle(int next);                  // Switches color only if it differs
+    void moveTo(int line, int column);           // Cursor to frame-relative position (0-based)
+
+public:
+    explicit BoardRenderer(int top = 0);
+    int renderFrame(const SudokuGame& game);     // Whole board, returns bytes rendered
+    int renderChanges(const SudokuGame& game);   // Changed cells only (anchored), else whole board
+    void invalidate();                           // Next renderChanges redraws everything
+    const char* data() const;                    // Rendered bytes
+    int size() const;                            // Number of rendered bytes
+    bool writeTo(int fd) const;                  // Emits the rendered bytes with one write
+};
+
+void renderSolution(ostream& out, const SudokuGame& game);  // Full solution grid
+void renderHint(ostream& out, const Hint& hint);            // Where a hint was placed and why
+
+#endif
@@ -0,0 +1,57 @@
+#ifndef RNG_H
+#define RNG_H
+
+#include <cstdint>
+
+// xoshiro256** pseudo-random generator (Blackman & Vigna)
+// Small, fast and owned per instance, so generators running on different
+// threads never share state. The same seed always gives the same sequence.
+class Xoshiro256 {
+private:
+    uint64_t state[4];
+
+    static uint64_t rotl(uint64_t x, int k)
+    {
+        return (x << k) | (x >> (64 - k));
+    }
+
+public:
+    explicit Xoshiro256(uint64_t seed = 0)
+    {
+        reseed(seed);
+    }
+
+    // Expands a 64-bit seed into the full state with splitmix64
+    void reseed(uint64_t seed)
+    {
+        for (int i = 0; i < 4; i++)
+        {
+            seed += 0x9E3779B97F4A7C15ULL;
+            uint64_t z = seed;
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            state[i] = z ^ (z >> 31);
+        }
+    }
+
+    uint64_t next()
+    {
+        uint64_t result = rotl(state[1] * 5, 7) * 9;
+        uint64_t t = state[1] << 17;
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= t;
+        state[3] = rotl(state[3], 45);
+        return result;
+    }
+
+    // Uniform value in [0, bound) by multiply-shift, no division
+    uint32_t below(uint32_t bound)
+    {
+        return (uint32_t)(((next() >> 32) * bound) >> 32);
+    }
+};
+
+#endif
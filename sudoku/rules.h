@@ -0,0 +1,175 @@
+#ifndef RULES_H
+#define RULES_H
+
+#include <cstdint>
+#include <cstring>
+#include "tables.h"
+
+// Rule sets for GridBoard and GridSolver, fixed at compile time. Every set
+// has the classic rows, columns and boxes, and may add
+//   - extra units, regions whose digits must all differ (unitCell), and
+//   - extra peers, cells that must differ without sharing a region, such
+//     as cells a knight's move apart (isPeer).
+// makeRuleTables flattens a set into tables where every cell has the same
+// number of unit and peer slots (padding repeats the cell's row, or points
+// at an always-empty cell), so a candidate lookup is a fixed-length,
+// branch-free loop and each variant compiles to its own inner loop.
+
+// Variants selectable at runtime (sudoku-solve -V, sudoku-gen --variant)
+enum Variant {
+    VARIANT_CLASSIC,                             // Rows, columns, boxes
+    VARIANT_DIAGONAL,                            // X-Sudoku: both main diagonals too
+    VARIANT_WINDOKU,                             // Four extra 3x3 windows
+    VARIANT_ANTIKNIGHT,                          // No digit repeats a knight's move away
+    VARIANT_COUNT
+};
+
+// Plain rows, columns and boxes, for any box size
+template <int SIZE>
+struct ClassicRules {
+    static constexpr int BOX = SIZE;
+    static constexpr int EXTRA_UNITS = 0;
+    static constexpr int CELL_UNITS = 3;         // Most units any cell belongs to
+    static constexpr int PEERS = 0;              // Most extra peers any cell has
+    static constexpr int unitCell(int, int) { return 0; }
+    static constexpr bool isPeer(int, int) { return false; }
+};
+
+// X-Sudoku: both 9-cell diagonals are units
+struct DiagonalRules {
+    static constexpr int BOX = 3;
+    static constexpr int EXTRA_UNITS = 2;
+    static constexpr int CELL_UNITS = 5;         // The center is on both diagonals
+    static constexpr int PEERS = 0;
+    static constexpr int unitCell(int unit, int i) { return unit == 0 ? i * 10 : (i + 1) * 8; }
+    static constexpr bool isPeer(int, int) { return false; }
+};
+
+// Windoku: four 3x3 windows at rows and columns 2-4 and 6-8 are units
+struct WindokuRules {
+    static constexpr int BOX = 3;
+    static constexpr int EXTRA_UNITS = 4;
+    static constexpr int CELL_UNITS = 4;
+    static constexpr int PEERS = 0;
+    static constexpr int unitCell(int unit, int i) { return (1 + (unit / 2) * 4 + i / 3) * 9 + 1 + (unit % 2) * 4 + i % 3; }
+    static constexpr bool isPeer(int, int) { return false; }
+};
+
+// Anti-knight: cells a chess knight's move apart hold different digits
+struct AntiKnightRules {
+    static constexpr int BOX = 3;
+    static constexpr int EXTRA_UNITS = 0;
+    static constexpr int CELL_UNITS = 3;
+    static constexpr int PEERS = 8;
+    static constexpr int unitCell(int, int) { return 0; }
+    static constexpr bool isPeer(int a, int b)
+    {
+        int rows = a / 9 > b / 9 ? a / 9 - b / 9 : b / 9 - a / 9;
+        int cols = a % 9 > b % 9 ? a % 9 - b % 9 : b % 9 - a % 9;
+        return (rows == 1 && cols == 2) || (rows == 2 && cols == 1);
+    }
+};
+
+// Flat unit and peer tables of one rule set
+template <int BOX, int EXTRA_UNITS, int CELL_UNITS, int PEERS>
+struct RuleTables {
+    typedef GridTraits<BOX> T;
+    static constexpr int UNITS = T::UNITS + EXTRA_UNITS;
+    typename T::Index units[UNITS][T::N];        // Cells of each unit, classic units first
+    uint8_t cellUnits[T::CELLS][CELL_UNITS];     // Row, column, box, then extra units padded with the row
+    uint16_t peers[T::CELLS][PEERS > 0 ? PEERS : 1]; // Extra peers, padded with T::CELLS
+};
+
+template <typename Rules>
+using RuleTablesOf = RuleTables<Rules::BOX, Rules::EXTRA_UNITS, Rules::CELL_UNITS, Rules::PEERS>;
+
+/**
+ * Builds a rule set's tables at compile time; a cell in more units or with
+ * more peers than the set declares fails to compile
+ * @return Tables for the rule set
+ */
+template <typename Rules>
+constexpr RuleTablesOf<Rules> makeRuleTables()
+{
+    typedef GridTraits<Rules::BOX> T;
+    typedef RuleTablesOf<Rules> R;
+    const GridTables<Rules::BOX>& classic = gridTables<Rules::BOX>;
+    R tables = {};
+    for (int unit = 0; unit < T::UNITS; unit++)
+    {
+        for (int i = 0; i < T::N; i++) tables.units[unit][i] = classic.units[unit][i];
+    }
+    for (int unit = 0; unit < Rules::EXTRA_UNITS; unit++)
+    {
+        for (int i = 0; i < T::N; i++) tables.units[T::UNITS + unit][i] = Rules::unitCell(unit, i);
+    }
+
+    int counts[T::CELLS] = {};
+    for (int cell = 0; cell < T::CELLS; cell++)
+    {
+        for (int kind = 0; kind < 3; kind++)
+        {
+            tables.cellUnits[cell][counts[cell]++] = kind * T::N + classic.cellUnits[cell][kind];
+        }
+    }
+    for (int unit = T::UNITS; unit < R::UNITS; unit++)
+    {
+        for (int i = 0; i < T::N; i++)
+        {
+            int cell = tables.units[unit][i];
+            tables.cellUnits[cell][counts[cell]++] = unit;
+        }
+    }
+    for (int cell = 0; cell < T::CELLS; cell++)
+    {
+        while (counts[cell] < Rules::CELL_UNITS) tables.cellUnits[cell][counts[cell]++] = tables.cellUnits[cell][0];
+
+        int peers = 0;
+        for (int other = 0; other < T::CELLS; other++)
+        {
+            if (other != cell && Rules::isPeer(cell, other)) tables.peers[cell][peers++] = other;
+        }
+        while (peers < (Rules::PEERS > 0 ? Rules::PEERS : 1)) tables.peers[cell][peers++] = T::CELLS;
+    }
+    return tables;
+}
+
+template <typename Rules>
+inline constexpr RuleTablesOf<Rules> ruleTables = makeRuleTables<Rules>();
+
+/**
+ * @param variant Variant
+ * @return Name used on the command line and in benchmark names
+ */
+inline const char* variantName(Variant variant)
+{
+    switch (variant)
+    {
+        case VARIANT_CLASSIC:    return "classic";
+        case VARIANT_DIAGONAL:   return "diagonal";
+        case VARIANT_WINDOKU:    return "windoku";
+        case VARIANT_ANTIKNIGHT: return "antiknight";
+        default:                 break;
+    }
+    return "unknown";
+}
+
+/**
+ * @param name Variant name, as returned by variantName
+ * @param variant [out] Parsed variant
+ * @return False if the name is unknown
+ */
+inline bool parseVariant(const char* name, Variant& variant)
+{
+    for (int v = 0; v < VARIANT_COUNT; v++)
+    {
+        if (strcmp(name, variantName((Variant)v)) == 0)
+        {
+            variant = (Variant)v;
+            return true;
+        }
+    }
+    return false;
+}
+
+#endif
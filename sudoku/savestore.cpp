@@ -0,0 +1,294 @@
+#include "savestore.h"
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/**
+ * 32-bit FNV-1a hash
+ * @param data Bytes to hash
+ * @param size Number of bytes
+ * @return Hash value
+ */
+uint32_t fnv1a(const uint8_t* data, size_t size)
+{
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < size; i++)
+    {
+        hash = (hash ^ data[i]) * 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * Packs 81 digits into 41 bytes, low nibble first
+ */
+static void packDigits(const uint8_t digits[81], uint8_t packed[41])
+{
+    for (int i = 0; i < 40; i++)
+    {
+        packed[i] = digits[2 * i] | (digits[2 * i + 1] << 4);
+    }
+    packed[40] = digits[80];
+}
+
+/**
+ * Unpacks 41 bytes into 81 digits
+ * @return False if any digit is out of range
+ */
+static bool unpackDigits(const uint8_t packed[41], uint8_t digits[81])
+{
+    for (int i = 0; i < 40; i++)
+    {
+        digits[2 * i] = packed[i] & 0xF;
+        digits[2 * i + 1] = packed[i] >> 4;
+    }
+    digits[80] = packed[40] & 0xF;
+    for (int cell = 0; cell < 81; cell++)
+    {
+        if (digits[cell] > 9) return false;
+    }
+    return true;
+}
+
+/**
+ * Packs a game into a save record and stamps its checksum
+ * @param game Game to save
+ * @param record [out] Encoded record
+ */
+void encodeSave(const GameData& game, SaveRecord& record)
+{
+    memset(&record, 0, sizeof(record));
+    record.magic = SAVE_RECORD_MAGIC;
+    record.version = SAVE_VERSION;
+    record.seed = game.seed;
+    record.fixedBits[0] = game.board.fixedBits[0];
+    record.fixedBits[1] = game.board.fixedBits[1];
+    packDigits(game.board.cells, record.cells);
+    packDigits(game.solution, record.solution);
+    record.hintsUsed = game.hintsUsed;
+    record.wrongAttempts = game.wrongAttempts;
+    record.difficulty = game.difficulty + 1;
+    record.checksum = fnv1a((const uint8_t*)&record, offsetof(SaveRecord, checksum));
+}
+
+/**
+ * Unpacks a save record; the board's unit masks are rebuilt from the digits
+ * @param record Record to decode
+ * @param game [out] Decoded game, untouched on failure
+ * @return False if the record is empty, from another version or damaged
+ */
+bool decodeSave(const SaveRecord& record, GameData& game)
+{
+    if (record.magic != SAVE_RECORD_MAGIC || record.version != SAVE_VERSION) return false;
+    if (record.checksum != fnv1a((const uint8_t*)&record, offsetof(SaveRecord, checksum))) return false;
+
+    GameData decoded;
+    uint8_t cells[81];
+    if (!unpackDigits(record.cells, cells) || !unpackDigits(record.solution, decoded.solution)) return false;
+    decoded.board.clear();
+    if (!decoded.board.load(cells)) return false;
+    decoded.board.fixedBits[0] = record.fixedBits[0];
+    decoded.board.fixedBits[1] = record.fixedBits[1];
+    decoded.hintsUsed = record.hintsUsed;
+    decoded.wrongAttempts = record.wrongAttempts;
+    decoded.seed = record.seed;
+    if (record.difficulty == 0 || record.difficulty > DIFFICULTY_COUNT) return false;
+    decoded.difficulty = record.difficulty - 1;
+    game = decoded;
+    return true;
+}
+
+/**
+ * SaveStore constructor - No file is open until open() succeeds
+ */
+SaveStore::SaveStore()
+{
+    fd = -1;
+    base = nullptr;
+    mappedSize = 0;
+}
+
+/**
+ * SaveStore destructor - Unmaps and closes the file
+ */
+SaveStore::~SaveStore()
+{
+    close();
+}
+
+/**
+ * Opens a store file, creating it with an empty header if needed
+ * @param path Store file path
+ * @param initialCapacity Slots to reserve when creating a new file,
+ *                        0 to only open an existing store
+ * @return False if the file cannot be opened or is not a compatible store,
+ *         or initialCapacity is above SAVE_MAX_SLOTS
+ */
+bool SaveStore::open(const char* path, uint64_t initialCapacity)
+{
+    close();
+    if (initialCapacity > SAVE_MAX_SLOTS) return false;
+    fd = ::open(path, initialCapacity > 0 ? O_RDWR | O_CREAT : O_RDWR, 0644);
+    if (fd < 0) return false;
+
+    struct stat info;
+    if (fstat(fd, &info) != 0)
+    {
+        close();
+        return false;
+    }
+
+    if (info.st_size == 0 && initialCapacity > 0)
+    {
+        uint64_t capacity = initialCapacity;
+        if (!map(capacity))
+        {
+            close();
+            return false;
+        }
+        header()->magic = SAVE_STORE_MAGIC;
+        header()->version = SAVE_VERSION;
+        header()->recordSize = sizeof(SaveRecord);
+        header()->capacity = capacity;
+        return true;
+    }
+
+    SaveStoreHeader stored;
+    if (info.st_size < (off_t)sizeof(stored) || pread(fd, &stored, sizeof(stored), 0) != (ssize_t)sizeof(stored) ||
+        stored.magic != SAVE_STORE_MAGIC || stored.version != SAVE_VERSION || stored.recordSize != sizeof(SaveRecord) ||
+        stored.capacity > SAVE_MAX_SLOTS || (uint64_t)info.st_size < sizeof(SaveStoreHeader) + stored.capacity * sizeof(SaveRecord))
+    {
+        close();
+        return false;
+    }
+    if (!map(stored.capacity))
+    {
+        close();
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Resizes the file to hold capacity slots and maps all of it
+ * New slots read as zero, which is an empty slot
+ * @param capacity Number of record slots
+ * @return False if the file cannot be resized or mapped, or its size does
+ *         not fit in size_t
+ */
+bool SaveStore::map(uint64_t capacity)
+{
+    if (capacity > (SIZE_MAX - sizeof(SaveStoreHeader)) / sizeof(SaveRecord)) return false;
+    size_t size = sizeof(SaveStoreHeader) + capacity * sizeof(SaveRecord);
+    struct stat info;
+    if (fstat(fd, &info) != 0) return false;
+    if ((uint64_t)info.st_size < size && ftruncate(fd, size) != 0) return false;
+
+    if (base) munmap(base, mappedSize);
+    void* mapped = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapped == MAP_FAILED)
+    {
+        base = nullptr;
+        mappedSize = 0;
+        return false;
+    }
+    base = (uint8_t*)mapped;
+    mappedSize = size;
+    return true;
+}
+
+/**
+ * Grows the file to at least minCapacity slots, doubling so that saving
+ * increasing IDs costs amortized O(1) remaps; never past SAVE_MAX_SLOTS
+ * @param minCapacity Slots required, at most SAVE_MAX_SLOTS
+ * @return False if the file cannot be grown
+ */
+bool SaveStore::grow(uint64_t minCapacity)
+{
+    uint64_t capacity = header()->capacity;
+    uint64_t target = capacity > 0 ? capacity : 1;
+    while (target < minCapacity) target *= 2;
+    if (target > SAVE_MAX_SLOTS) target = SAVE_MAX_SLOTS;
+    if (!map(target)) return false;
+    header()->capacity = target;
+    return true;
+}
+
+/**
+ * Unmaps and closes the store file
+ */
+void SaveStore::close()
+{
+    if (base) munmap(base, mappedSize);
+    if (fd >= 0) ::close(fd);
+    fd = -1;
+    base = nullptr;
+    mappedSize = 0;
+}
+
+/**
+ * Saves a game into its slot, growing the file if the ID is past the end
+ * @param id Game ID (slot index)
+ * @param game Game to save
+ * @return False if no store is open, the ID is SAVE_MAX_SLOTS or above,
+ *         or the file cannot grow
+ */
+bool SaveStore::save(uint64_t id, const GameData& game)
+{
+    if (!base || id >= SAVE_MAX_SLOTS) return false;
+    if (id >= header()->capacity && !grow(id + 1)) return false;
+    encodeSave(game, *slot(id));
+    return true;
+}
+
+/**
+ * Loads a game from its slot
+ * @param id Game ID (slot index)
+ * @param game [out] Loaded game, untouched on failure
+ * @return False if the slot is out of range, empty or damaged
+ */
+bool SaveStore::load(uint64_t id, GameData& game) const
+{
+    if (!base || id >= header()->capacity) return false;
+    return decodeSave(*slot(id), game);
+}
+
+/**
+ * Frees a slot
+ * @param id Game ID (slot index)
+ * @return False if the slot is out of range
+ */
+bool SaveStore::erase(uint64_t id)
+{
+    if (!base || id >= header()->capacity) return false;
+    memset(slot(id), 0, sizeof(SaveRecord));
+    return true;
+}
+
+/**
+ * @param id Game ID (slot index)
+ * @return True if the slot holds a game record
+ */
+bool SaveStore::contains(uint64_t id) const
+{
+    return base && id < header()->capacity && slot(id)->magic == SAVE_RECORD_MAGIC;
+}
+
+/**
+ * @return Slots currently in the file, 0 if no store is open
+ */
+uint64_t SaveStore::capacity() const
+{
+    return base ? header()->capacity : 0;
+}
+
+/**
+ * Writes dirty pages of the mapping back to disk
+ * @return False if no store is open or the sync fails
+ */
+bool SaveStore::flush()
+{
+    return base && msync(base, mappedSize, MS_SYNC) == 0;
+}
@@ -0,0 +1,78 @@
+#ifndef SAVESTORE_H
+#define SAVESTORE_H
+
+#include <cstddef>
+#include <cstdint>
+#include "sudoku.h"
+
+const uint32_t SAVE_RECORD_MAGIC = 0x524B4453;  // "SDKR"
+const uint32_t SAVE_STORE_MAGIC = 0x534B4453;   // "SDKS"
+const uint16_t SAVE_VERSION = 1;
+const uint64_t SAVE_MAX_SLOTS = 1ULL << 32;      // Highest slot count a store may have, 512 GB of records
+
+// One saved game in 128 bytes: digits packed two per byte, the fixed-cell
+// set, the solution and the counters, protected by a checksum. Row, column
+// and box masks are not stored; they are rebuilt from the digits on load.
+struct SaveRecord {
+    uint32_t magic;                              // SAVE_RECORD_MAGIC when the slot is in use
+    uint16_t version;
+    uint16_t reserved;
+    uint64_t seed;
+    uint64_t fixedBits[2];
+    uint8_t cells[41];                           // Board digits, two 4-bit digits per byte
+    uint8_t solution[41];                        // Solution digits, same packing
+    uint16_t hintsUsed;
+    uint16_t wrongAttempts;
+    uint8_t difficulty;                          // Difficulty + 1, so a zeroed field reads as damaged
+    uint8_t padding[5];
+    uint32_t checksum;                           // FNV-1a of every byte before it
+};
+
+static_assert(sizeof(SaveRecord) == 128, "SaveRecord layout is part of the file format");
+
+// Store file header, followed by capacity SaveRecord slots
+struct SaveStoreHeader {
+    uint32_t magic;                              // SAVE_STORE_MAGIC
+    uint16_t version;
+    uint16_t recordSize;                         // sizeof(SaveRecord)
+    uint64_t capacity;                           // Slots in the file
+    uint8_t reserved[48];
+};
+
+static_assert(sizeof(SaveStoreHeader) == 64, "SaveStoreHeader layout is part of the file format");
+
+uint32_t fnv1a(const uint8_t* data, size_t size);        // 32-bit FNV-1a, the checksum of save and journal records
+void encodeSave(const GameData& game, SaveRecord& record);  // Packs a game into a record
+bool decodeSave(const SaveRecord& record, GameData& game);  // Unpacks, false if damaged or foreign
+
+// Memory-mapped file of fixed-size save slots indexed by game ID.
+// Saving or loading a game is a copy into or out of its slot; the file
+// grows (doubling) when an ID past the end is saved. Not thread-safe.
+class SaveStore {
+private:
+    int fd;
+    uint8_t* base;                               // Mapping of the whole file
+    size_t mappedSize;
+
+    SaveStoreHeader* header() const { return (SaveStoreHeader*)base; }
+    SaveRecord* slot(uint64_t id) const { return (SaveRecord*)(base + sizeof(SaveStoreHeader)) + id; }
+    bool map(uint64_t capacity);                 // Sizes the file and maps it
+    bool grow(uint64_t minCapacity);
+
+public:
+    SaveStore();
+    ~SaveStore();
+    SaveStore(const SaveStore&) = delete;
+    SaveStore& operator=(const SaveStore&) = delete;
+
+    bool open(const char* path, uint64_t initialCapacity = 1024); // Opens or creates (capacity > 0) a store
+    void close();
+    bool save(uint64_t id, const GameData& game); // Writes a game to its slot
+    bool load(uint64_t id, GameData& game) const; // False if the slot is empty or damaged
+    bool erase(uint64_t id);                     // Frees a slot
+    bool contains(uint64_t id) const;            // True if the slot holds a game
+    uint64_t capacity() const;                   // Slots currently in the file
+    bool flush();                                // Writes dirty pages to disk
+};
+
+#endif
@@ -0,0 +1,623 @@
+#include <iostream>
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include "sudoku.h"
+#include "session.h"
+#include "savestore.h"
+#include "journal.h"
+using namespace std;
+
+// Request bytes buffered per connection; a longer line drops the connection
+static const int READ_BUFFER = 4096;
+static const int MAX_EVENTS = 256;
+// Unsent response bytes past which a connection is not read until the
+// client catches up, and past which it is dropped
+static const size_t OUTPUT_HIGH_WATER = 64 << 10;
+static const size_t OUTPUT_LIMIT = 1 << 20;
+// Save slots one connection may hold at a time
+static const size_t MAX_CONNECTION_SLOTS = 64;
+
+struct ServerOptions {
+    const char* unixPath = nullptr;              // Unix socket path, or
+    int port = 0;                                // loopback TCP port
+    uint32_t maxSessions = 131072;
+    const char* store = "sudoku_server.dat";     // Save store for SAVE and LOAD
+    uint64_t slots = 65536;                      // Save slots clients may use, the store's capacity
+    const char* journal = nullptr;               // Move journal, nullptr to keep explicit saves only
+    uint64_t journalLimit = 64 << 20;            // Journal bytes that trigger a compaction
+    int poolThreads = 1;                         // Background puzzle generators
+    size_t poolSize = 1024;                      // Ready puzzles per difficulty
+    const char* poolFile = nullptr;              // Warm start and shutdown dump
+};
+
+// One client: unparsed request bytes and response bytes not yet sent
+struct Connection {
+    int fd;
+    int inLength;
+    char in[READ_BUFFER];
+    string out;
+    size_t outSent;                              // Bytes of out already written
+    uint32_t events;                             // Events registered with epoll
+    vector<uint64_t> sessions;                   // Live sessions opened here, closed with the connection
+    uint64_t serial;                             // Unique per connection, unlike fd; owner of its save slots
+    vector<uint64_t> slots;                      // Save slots held here, released with the connection
+};
+
+static volatile sig_atomic_t stopping = 0;
+static int epollFd = -1;
+static int connections = 0;
+static uint64_t connectionSerial = 0;            // Last serial given to a connection
+static vector<uint64_t> slotOwners;              // Serial of the connection holding each save slot, 0 if free
+
+/**
+ * Stops the event loop on SIGINT or SIGTERM
+ */
+static void onSignal(int)
+{
+    stopping = 1;
+}
+
+/**
+ * Reads the next space-separated number of a request
+ * @param p [in,out] Parse position, moved past the number
+ * @param value [out] Parsed number
+ * @return False if there is no number at p
+ */
+static bool nextNumber(const char*& p, uint64_t& value)
+{
+    while (*p == ' ') p++;
+    if (*p < '0' || *p > '9') return false;
+    char* end;
+    value = strtoull(p, &end, 10);
+    p = end;
+    return true;
+}
+
+/**
+ * Appends the 81 board digits of a game (0 for empty) to a response
+ * @param out Response buffer
+ * @param game Game to serialize
+ */
+static void appendBoard(string& out, const SudokuGame& game)
+{
+    char text[81];
+    for (int cell = 0; cell < 81; cell++)
+    {
+        text[cell] = '0' + game.getCell(cell / 9, cell % 9);
+    }
+    out.append(text, 81);
+}
+
+/**
+ * Claims a save slot for a connection: a slot is held by the connection
+ * that last saved or loaded it until that connection closes, and no other
+ * connection may save over it or load it meanwhile
+ * @param conn Connection asking for the slot
+ * @param slot Save slot, below the configured slot count
+ * @return Error response, or nullptr if the connection now holds the slot
+ */
+static const char* claimSlot(Connection& conn, uint64_t slot)
+{
+    if (slotOwners[slot] == conn.serial) return nullptr;
+    if (slotOwners[slot] != 0) return "ERR taken\n";
+    if (conn.slots.size() == MAX_CONNECTION_SLOTS) return "ERR slots\n";
+    slotOwners[slot] = conn.serial;
+    conn.slots.push_back(slot);
+    return nullptr;
+}
+
+/**
+ * Executes one request line and appends its one-line response
+ * Requests: NEW [seed|difficulty], MOVE id row col num, HINT id, BOARD id,
+ * SAVE id slot, LOAD id slot, CLOSE id, STATS
+ * Responses start with OK or ERR. With a journal open, SAVE and LOAD also
+ * journal the session's later moves to the slot. Slots are held per
+ * connection (claimSlot).
+ * @param conn Connection the request came from (owner of its sessions)
+ * @param line Request without the newline, NUL-terminated
+ * @param arena Session arena
+ * @param store Save store
+ * @param journal Move journal in front of the store, possibly not open
+ * @param pool Ready puzzles for NEW
+ */
+static void handleRequest(Connection& conn, const char* line, SessionArena& arena, SaveStore& store, MoveJournal& journal,
+                          PuzzlePool& pool)
+{
+    string& out = conn.out;
+    const char* p = line;
+    while (*p == ' ') p++;
+    const char* command = p;
+    while (*p && *p != ' ') p++;
+    size_t commandLength = p - command;
+    auto is = [&](const char* name) { return commandLength == strlen(name) && memcmp(command, name, commandLength) == 0; };
+
+    uint64_t id = 0, a = 0, b = 0, c = 0;
+    char text[96];
+    if (is("NEW"))
+    {
+        if (arena.size() == arena.capacity())
+        {
+            out += "ERR full\n";
+            return;
+        }
+
+        // A seed always generates; otherwise start on a pooled puzzle and
+        // only generate on the event loop when the pool has run dry
+        uint64_t seed;
+        PooledPuzzle pooled;
+        Difficulty difficulty;
+        while (*p == ' ') p++;
+        if (nextNumber(p, seed)) id = arena.create(conn.fd, seed);
+        else if (!*p) id = pool.takeAny(pooled) ? arena.create(conn.fd, pooled) : arena.create(conn.fd);
+        else if (!parseDifficulty(p, difficulty))
+        {
+            out += "ERR args\n";
+            return;
+        }
+        else if (pool.take(difficulty, pooled)) id = arena.create(conn.fd, pooled);
+        else
+        {
+            out += "ERR empty\n";
+            return;
+        }
+        conn.sessions.push_back(id);
+        snprintf(text, sizeof(text), "OK %llu ", (unsigned long long)id);
+        out += text;
+        appendBoard(out, *arena.find(id, conn.fd));
+        out += '\n';
+        return;
+    }
+    if (is("STATS"))
+    {
+        snprintf(text, sizeof(text), "OK %u %d\n", arena.size(), connections);
+        out += text;
+        return;
+    }
+    if (!is("MOVE") && !is("HINT") && !is("BOARD") && !is("SAVE") && !is("LOAD") && !is("CLOSE"))
+    {
+        out += "ERR command\n";
+        return;
+    }
+
+    // Every other request names a session
+    if (!nextNumber(p, id))
+    {
+        out += "ERR args\n";
+        return;
+    }
+    SudokuGame* game = arena.find(id, conn.fd);
+    if (!game)
+    {
+        out += "ERR session\n";
+        return;
+    }
+
+    if (is("MOVE"))
+    {
+        if (!nextNumber(p, a) || !nextNumber(p, b) || !nextNumber(p, c))
+        {
+            out += "ERR args\n";
+            return;
+        }
+        out += "OK ";
+        out += moveResultName(game->makeMove((int)min<uint64_t>(a, 10), (int)min<uint64_t>(b, 10), (int)min<uint64_t>(c, 10)));
+        out += '\n';
+    }
+    else if (is("HINT"))
+    {
+        Hint hint;
+        if (!game->provideHint(hint))
+        {
+            out += "ERR nohint\n";
+            return;
+        }
+        snprintf(text, sizeof(text), "OK %d %d %d\n", Board::rowOf(hint.cell) + 1, Board::colOf(hint.cell) + 1, hint.digit);
+        out += text;
+    }
+    else if (is("BOARD"))
+    {
+        out += "OK ";
+        appendBoard(out, *game);
+        out += '\n';
+    }
+    else if (is("SAVE") || is("LOAD"))
+    {
+        if (!nextNumber(p, a) || a >= slotOwners.size())
+        {
+            out += "ERR args\n";
+            return;
+        }
+        if (const char* error = claimSlot(conn, a))
+        {
+            out += error;
+            return;
+        }
+        if (is("SAVE"))
+        {
+            bool saved = journal.isOpen() ? game->attachJournal(journal, a) : game->saveGame(store, a);
+            out += saved ? "OK\n" : "ERR store\n";
+        }
+        else if (journal.isOpen() ? game->loadGame(journal, a) : game->loadGame(store, a))
+        {
+            if (journal.isOpen()) game->attachJournal(journal, a);
+            out += "OK ";
+            appendBoard(out, *game);
+            out += '\n';
+        }
+        else
+        {
+            out += "ERR store\n";
+        }
+    }
+    else  // CLOSE
+    {
+        arena.release(id);
+        auto open = find(conn.sessions.begin(), conn.sessions.end(), id);
+        *open = conn.sessions.back();
+        conn.sessions.pop_back();
+        out += "OK\n";
+    }
+}
+
+/**
+ * Closes a connection and every session it owns and releases its save
+ * slots, O(its sessions and slots)
+ * @param conn Connection to close; deleted on return
+ * @param arena Session arena
+ */
+static void closeConnection(Connection* conn, SessionArena& arena)
+{
+    for (uint64_t id : conn->sessions) arena.release(id);
+    for (uint64_t slot : conn->slots) slotOwners[slot] = 0;
+    epoll_ctl(epollFd, EPOLL_CTL_DEL, conn->fd, nullptr);
+    close(conn->fd);
+    delete conn;
+    connections--;
+}
+
+/**
+ * Writes as much pending output as the socket takes; waits for EPOLLOUT
+ * only while output is left over, and stops reading requests while more
+ * than OUTPUT_HIGH_WATER bytes are left over
+ * @param conn Connection to flush
+ * @return False if the connection failed
+ */
+static bool flushConnection(Connection& conn)
+{
+    while (conn.outSent < conn.out.size())
+    {
+        ssize_t n = send(conn.fd, conn.out.data() + conn.outSent, conn.out.size() - conn.outSent, MSG_NOSIGNAL);
+        if (n < 0)
+        {
+            if (errno == EINTR) continue;
+            if (errno != EAGAIN && errno != EWOULDBLOCK) return false;
+            break;
+        }
+        conn.outSent += n;
+    }
+
+    size_t pending = conn.out.size() - conn.outSent;
+    if (pending == 0)
+    {
+        conn.out.clear();
+        conn.outSent = 0;
+    }
+    uint32_t events = (pending > OUTPUT_HIGH_WATER ? 0 : EPOLLIN) | (pending > 0 ? EPOLLOUT : 0);
+    if (events != conn.events)
+    {
+        epoll_event event;
+        event.events = events;
+        event.data.ptr = &conn;
+        if (epoll_ctl(epollFd, EPOLL_CTL_MOD, conn.fd, &event) < 0) return false;
+        conn.events = events;
+    }
+    return true;
+}
+
+/**
+ * Reads available requests and executes every complete line; the responses
+ * are sent by flushConnection once the journal has committed their moves.
+ * Reading stops at OUTPUT_HIGH_WATER unsent bytes (the rest stays in the
+ * socket), and a connection past OUTPUT_LIMIT is dropped.
+ * @param conn Readable connection
+ * @param arena Session arena
+ * @param store Save store
+ * @param journal Move journal
+ * @param pool Ready puzzles for NEW
+ * @return False if the peer closed or the connection failed
+ */
+static bool readConnection(Connection& conn, SessionArena& arena, SaveStore& store, MoveJournal& journal, PuzzlePool& pool)
+{
+    while (conn.out.size() - conn.outSent <= OUTPUT_HIGH_WATER)
+    {
+        ssize_t n = read(conn.fd, conn.in + conn.inLength, READ_BUFFER - conn.inLength);
+        if (n == 0) return false;
+        if (n < 0)
+        {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+            return false;
+        }
+        conn.inLength += n;
+
+        // Execute complete lines, keep a trailing partial line
+        char* start = conn.in;
+        char* end = conn.in + conn.inLength;
+        char* newline;
+        while ((newline = (char*)memchr(start, '\n', end - start)) != nullptr)
+        {
+            *newline = '\0';
+            if (newline > start && newline[-1] == '\r') newline[-1] = '\0';
+            handleRequest(conn, start, arena, store, journal, pool);
+            start = newline + 1;
+        }
+        conn.inLength = end - start;
+        if (conn.inLength == READ_BUFFER) return false;  // Line too long
+        if (conn.out.size() - conn.outSent > OUTPUT_LIMIT) return false;
+        memmove(conn.in, start, conn.inLength);
+    }
+    return true;
+}
+
+/**
+ * Creates the listening socket
+ * @param options Unix path or TCP port
+ * @return Socket, -1 on failure
+ */
+static int openListener(const ServerOptions& options)
+{
+    int fd;
+    if (options.unixPath)
+    {
+        sockaddr_un addr;
+        memset(&addr, 0, sizeof(addr));
+        addr.sun_family = AF_UNIX;
+        if (strlen(options.unixPath) >= sizeof(addr.sun_path)) return -1;
+        strcpy(addr.sun_path, options.unixPath);
+        fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        unlink(options.unixPath);
+        if (fd < 0 || bind(fd, (sockaddr*)&addr, sizeof(addr)) < 0) return -1;
+    }
+    else
+    {
+        sockaddr_in addr;
+        memset(&addr, 0, sizeof(addr));
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(options.port);
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        int on = 1;
+        if (fd < 0) return -1;
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+        if (bind(fd, (sockaddr*)&addr, sizeof(addr)) < 0) return -1;
+    }
+    if (listen(fd, SOMAXCONN) < 0) return -1;
+    return fd;
+}
+
+/**
+ * Accepts every pending connection
+ * @param listener Listening socket
+ * @param tcp Disable Nagle on accepted sockets
+ */
+static void acceptConnections(int listener, bool tcp)
+{
+    while (true)
+    {
+        int fd = accept4(listener, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0)
+        {
+            if (errno == EINTR || errno == ECONNABORTED) continue;
+            if (errno != EAGAIN && errno != EWOULDBLOCK) perror("accept");
+            return;
+        }
+        if (tcp)
+        {
+            int on = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+        }
+
+        Connection* conn = new Connection;
+        conn->fd = fd;
+        conn->inLength = 0;
+        conn->outSent = 0;
+        conn->events = EPOLLIN;
+        conn->serial = ++connectionSerial;
+        epoll_event event;
+        event.events = EPOLLIN;
+        event.data.ptr = conn;
+        if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) < 0)
+        {
+            close(fd);
+            delete conn;
+            continue;
+        }
+        connections++;
+    }
+}
+
+/**
+ * Prints command-line usage
+ */
+static void printUsage()
+{
+    cerr << "Usage: sudoku-server (-u SOCKET | -p PORT) [-n MAX_SESSIONS] [--store FILE] [--slots N]\n"
+         << "                     [--journal FILE] [--journal-limit MB]\n"
+         << "                     [--pool-threads N] [--pool-size N] [--pool-file FILE]\n"
+         << "  -u SOCKET      listen on a Unix socket\n"
+         << "  -p PORT        listen on 127.0.0.1:PORT\n"
+         << "  -n SESSIONS    session arena size (default 131072)\n"
+         << "  --store FILE   save store for SAVE and LOAD (default sudoku_server.dat)\n"
+         << "  --slots N      save slots 0..N-1 clients may use (default 65536)\n"
+         << "  --journal FILE after SAVE or LOAD, journal every move of the session to its slot\n"
+         << "  --journal-limit MB  compact the journal into the store past this size (default 64)\n"
+         << "  --pool-threads N  background puzzle generators (default 1)\n"
+         << "  --pool-size N  ready puzzles kept per difficulty (default 1024)\n"
+         << "  --pool-file FILE  warm-start the pool from FILE, write it back on shutdown\n"
+         << "Protocol, one request per line, one OK or ERR line per request:\n"
+         << "  NEW [seed|difficulty]  OK id board (difficulty: ERR empty if none ready)\n"
+         << "  MOVE id row col num    OK correct|solved|fixed|conflict|wrong|gameover|range\n"
+         << "  HINT id                OK row col num\n"
+         << "  BOARD id               OK board\n"
+         << "  SAVE id slot           OK (ERR taken if another connection holds the slot)\n"
+         << "  LOAD id slot           OK board (the slot is held until the connection closes)\n"
+         << "  CLOSE id               OK\n"
+         << "  STATS                  OK sessions connections\n";
+}
+
+/**
+ * Server entry point: one thread, one epoll loop, all sessions in one arena
+ */
+int main(int argc, char* argv[])
+{
+    ServerOptions options;
+    for (int i = 1; i < argc; i++)
+    {
+        bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "-u") == 0 && hasValue) options.unixPath = argv[++i];
+        else if (strcmp(argv[i], "-p") == 0 && hasValue) options.port = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-n") == 0 && hasValue) options.maxSessions = strtoul(argv[++i], nullptr, 10);
+        else if (strcmp(argv[i], "--store") == 0 && hasValue) options.store = argv[++i];
+        else if (strcmp(argv[i], "--slots") == 0 && hasValue) options.slots = strtoull(argv[++i], nullptr, 10);
+        else if (strcmp(argv[i], "--journal") == 0 && hasValue) options.journal = argv[++i];
+        else if (strcmp(argv[i], "--journal-limit") == 0 && hasValue) options.journalLimit = strtoull(argv[++i], nullptr, 10) << 20;
+        else if (strcmp(argv[i], "--pool-threads") == 0 && hasValue) options.poolThreads = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--pool-size") == 0 && hasValue) options.poolSize = strtoul(argv[++i], nullptr, 10);
+        else if (strcmp(argv[i], "--pool-file") == 0 && hasValue) options.poolFile = argv[++i];
+        else
+        {
+            printUsage();
+            return 1;
+        }
+    }
+    if ((!options.unixPath && options.port <= 0) || options.maxSessions == 0 || options.slots == 0)
+    {
+        printUsage();
+        return 1;
+    }
+
+    SaveStore store;
+    if (!store.open(options.store, options.slots))
+    {
+        cerr << "Error: Could not open save store " << options.store << "\n";
+        return 1;
+    }
+    slotOwners.assign(options.slots, 0);
+    MoveJournal journal(store);
+    if (options.journal)
+    {
+        long replayed = journal.open(options.journal);
+        if (replayed < 0)
+        {
+            cerr << "Error: Could not open journal " << options.journal << "\n";
+            return 1;
+        }
+        if (replayed > 0) cerr << "Recovered " << replayed << " journal records from " << options.journal << "\n";
+        for (uint64_t slot : journal.getUnreadable())
+        {
+            cerr << "Warning: Journal slot " << slot << " has no readable snapshot; its records are kept in "
+                 << journal.getUnreadablePath() << "\n";
+        }
+    }
+    SessionArena arena(options.maxSessions);
+    PuzzlePool pool(options.poolSize, options.poolThreads);
+    if (options.poolFile)
+    {
+        long loaded = pool.loadFile(options.poolFile);
+        if (loaded >= 0) cerr << "Warm start: " << loaded << " puzzles from " << options.poolFile << "\n";
+    }
+
+    int listener = openListener(options);
+    if (listener < 0)
+    {
+        perror("listen");
+        return 1;
+    }
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    epoll_event event;
+    event.events = EPOLLIN;
+    event.data.ptr = nullptr;                    // nullptr marks the listener
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, listener, &event);
+
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = onSignal;                // No SA_RESTART: epoll_wait returns EINTR
+    sigaction(SIGINT, &action, nullptr);
+    sigaction(SIGTERM, &action, nullptr);
+    signal(SIGPIPE, SIG_IGN);
+
+    cerr << "sudoku-server listening on " << (options.unixPath ? options.unixPath : "127.0.0.1:" + to_string(options.port))
+         << ", " << options.maxSessions << " sessions\n";
+
+    epoll_event events[MAX_EVENTS];
+    vector<Connection*> ready;                   // Connections with responses to send
+    ready.reserve(MAX_EVENTS);
+    while (!stopping)
+    {
+        int n = epoll_wait(epollFd, events, MAX_EVENTS, -1);
+        if (n < 0)
+        {
+            if (errno == EINTR) continue;
+            perror("epoll_wait");
+            break;
+        }
+        for (int i = 0; i < n; i++)
+        {
+            Connection* conn = (Connection*)events[i].data.ptr;
+            if (!conn)
+            {
+                acceptConnections(listener, !options.unixPath);
+                continue;
+            }
+            bool alive = true;
+            if (events[i].events & EPOLLIN) alive = readConnection(*conn, arena, store, journal, pool);
+            else if (events[i].events & (EPOLLERR | EPOLLHUP)) alive = false;
+            if (alive) ready.push_back(conn);
+            else closeConnection(conn, arena);
+        }
+
+        // Group commit: one write and one fsync make every move of this pass
+        // durable before any of its responses goes out. If the commit fails,
+        // every connection of the pass is dropped unanswered, so no client
+        // sees OK for a move that may be lost.
+        bool committed = !journal.isOpen() || journal.commit();
+        if (!committed) perror("journal");
+        for (Connection* conn : ready)
+        {
+            if (!committed || !flushConnection(*conn)) closeConnection(conn, arena);
+        }
+        ready.clear();
+        if (journal.isOpen() && journal.size() > options.journalLimit && !journal.compact()) perror("journal compaction");
+    }
+
+    cerr << "Shutting down: " << arena.size() << " sessions, " << connections << " connections\n";
+    if (journal.isOpen())
+    {
+        cerr << "Journal: " << journal.getCommits() << " group commits\n";
+        journal.close();
+    }
+    store.flush();
+    if (options.poolFile)
+    {
+        long saved = pool.saveFile(options.poolFile);
+        if (saved >= 0) cerr << "Saved " << saved << " ready puzzles to " << options.poolFile << "\n";
+        else cerr << "Error: Could not write " << options.poolFile << "\n";
+    }
+    close(listener);
+    if (options.unixPath) unlink(options.unixPath);
+    return 0;
+}
@@ -0,0 +1,135 @@
+#include "session.h"
+#include <new>
+
+/**
+ * SessionArena constructor - Reserves storage for all sessions
+ * @param capacity Maximum number of live sessions
+ */
+SessionArena::SessionArena(uint32_t capacity)
+    : storage(new unsigned char[(size_t)capacity * sizeof(SudokuGame)]),
+      generations(capacity, 0), owners(capacity, -1), slotCount(capacity), liveCount(0)
+{
+    static_assert(alignof(SudokuGame) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__, "Slots rely on operator new alignment");
+    static_assert(sizeof(SudokuGame) % alignof(SudokuGame) == 0, "Slots must stay aligned");
+    freeSlots.reserve(capacity);
+    for (uint32_t i = capacity; i > 0; i--)
+    {
+        freeSlots.push_back(i - 1);  // Low slots first, so used storage stays dense
+    }
+}
+
+/**
+ * SessionArena destructor - Destroys every live game
+ */
+SessionArena::~SessionArena()
+{
+    for (uint32_t i = 0; i < slotCount; i++)
+    {
+        if (generations[i] & 1) slot(i)->~SudokuGame();
+    }
+}
+
+/**
+ * Takes a slot off the free list and marks it live
+ * @param owner Owner tag stored with the session
+ * @param index [out] Slot index
+ * @return Session ID, 0 if the arena is full
+ */
+uint64_t SessionArena::acquire(int owner, uint32_t& index)
+{
+    if (freeSlots.empty()) return 0;
+    index = freeSlots.back();
+    freeSlots.pop_back();
+    generations[index]++;
+    owners[index] = owner;
+    liveCount++;
+    return ((uint64_t)generations[index] << 32) | index;
+}
+
+/**
+ * Starts a new game with a fresh random seed
+ * @param owner Tag that find() must be given to reach the session
+ * @return Session ID, 0 if the arena is full
+ */
+uint64_t SessionArena::create(int owner)
+{
+    uint32_t index;
+    uint64_t id = acquire(owner, index);
+    if (id) new (slot(index)) SudokuGame();
+    return id;
+}
+
+/**
+ * Starts a new reproducible game
+ * @param owner Tag that find() must be given to reach the session
+ * @param seed Puzzle seed
+ * @return Session ID, 0 if the arena is full
+ */
+uint64_t SessionArena::create(int owner, uint64_t seed)
+{
+    uint32_t index;
+    uint64_t id = acquire(owner, index);
+    if (id) new (slot(index)) SudokuGame(seed);
+    return id;
+}
+
+/**
+ * Starts a game on a pre-generated puzzle, without generating
+ * @param owner Tag that find() must be given to reach the session
+ * @param pooled Puzzle taken from a PuzzlePool
+ * @return Session ID, 0 if the arena is full
+ */
+uint64_t SessionArena::create(int owner, const PooledPuzzle& pooled)
+{
+    uint32_t index;
+    uint64_t id = acquire(owner, index);
+    if (id) new (slot(index)) SudokuGame(pooled);
+    return id;
+}
+
+/**
+ * Looks up a session
+ * @param id Session ID from create()
+ * @param owner Owner tag given to create()
+ * @return The game, or nullptr if the ID is stale, unknown or foreign
+ */
+SudokuGame* SessionArena::find(uint64_t id, int owner) const
+{
+    uint32_t index = (uint32_t)id;
+    if (index >= slotCount || generations[index] != (uint32_t)(id >> 32) || !(generations[index] & 1)) return nullptr;
+    if (owners[index] != owner) return nullptr;
+    return slot(index);
+}
+
+/**
+ * Closes a session and returns its slot to the free list
+ * @param id Session ID from create()
+ * @return False if the session is not live
+ */
+bool SessionArena::release(uint64_t id)
+{
+    uint32_t index = (uint32_t)id;
+    if (index >= slotCount || generations[index] != (uint32_t)(id >> 32) || !(generations[index] & 1)) return false;
+    slot(index)->~SudokuGame();
+    generations[index]++;
+    owners[index] = -1;
+    freeSlots.push_back(index);
+    liveCount--;
+    return true;
+}
+
+/**
+ * @return Number of live sessions
+ */
+uint32_t SessionArena::size() const
+{
+    return liveCount;
+}
+
+/**
+ * @return Maximum number of live sessions
+ */
+uint32_t SessionArena::capacity() const
+{
+    return slotCount;
+}
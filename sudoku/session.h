@@ -0,0 +1,45 @@
+#ifndef SESSION_H
+#define SESSION_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "sudoku.h"
+
+// Fixed-capacity arena of game sessions for hosting many players in one
+// process. Game storage is reserved once up front and only touched when a
+// slot is first used; slots are recycled through a free list, so creating
+// and closing sessions never allocates. Playing does: a game's undo history
+// grows by about 12 bytes per move up to MAX_HISTORY_NODES (history.h), and
+// a server session, which has no undo, stays under 81 moves (at most 1.5 KB
+// of history on top of its slot). A session ID is the slot index in the low
+// 32 bits and the slot's generation in the high 32 bits, so an ID from a
+// closed session never reaches the slot's next game.
+class SessionArena {
+private:
+    std::unique_ptr<unsigned char[]> storage;    // capacity SudokuGame-sized slots
+    std::vector<uint32_t> generations;           // Odd while the slot is live
+    std::vector<int> owners;                     // Owner tag of each live slot
+    std::vector<uint32_t> freeSlots;             // Stack of unused slot indexes
+    uint32_t slotCount;
+    uint32_t liveCount;
+
+    SudokuGame* slot(uint32_t index) const { return (SudokuGame*)(storage.get() + (size_t)index * sizeof(SudokuGame)); }
+    uint64_t acquire(int owner, uint32_t& index); // Pops a free slot, 0 when full
+
+public:
+    explicit SessionArena(uint32_t capacity);
+    ~SessionArena();
+    SessionArena(const SessionArena&) = delete;
+    SessionArena& operator=(const SessionArena&) = delete;
+
+    uint64_t create(int owner);                  // New random game, 0 when full
+    uint64_t create(int owner, uint64_t seed);   // New reproducible game, 0 when full
+    uint64_t create(int owner, const PooledPuzzle& pooled); // Game on a pre-generated puzzle, 0 when full
+    SudokuGame* find(uint64_t id, int owner) const; // Live game owned by owner, nullptr otherwise
+    bool release(uint64_t id);                   // Closes a session, false if not live
+    uint32_t size() const;                       // Live sessions
+    uint32_t capacity() const;                   // Maximum live sessions
+};
+
+#endif
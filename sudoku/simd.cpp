@@ -0,0 +1,275 @@
+#include "simd.h"
+#include "tables.h"
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define SUDOKU_X86 1
+#endif
+
+namespace {
+
+const int LANES = 16;                            // Lanes per slice load: 9 units padded to a vector
+const int PADDED = 96;                           // 81 masks plus room for a 16-lane load at the end
+const uint16_t ALL_DIGITS = 0x1FF;
+
+// Digit mask for values 0-15 (0 and out-of-range values map to no digit)
+const uint16_t DIGIT_BIT[16] = { 0, 1, 2, 4, 8, 16, 32, 64, 128, 256, 0, 0, 0, 0, 0, 0 };
+
+// Digit masks of a grid stored twice, row-major and column-major, so that
+// every slice of a unit group is one contiguous load:
+//   columns: slice k is row k of byRow, lane j is column j
+//   rows:    slice k is row k of byCol, lane j is row j
+//   boxes:   slice 3*dr+dc of band g is row 3g+dr of byRow from column dc,
+//            lane 3b is box 3g+b
+struct MaskGrid {
+    alignas(32) uint16_t byRow[PADDED];
+    alignas(32) uint16_t byCol[PADDED];
+};
+
+// Slice offsets into a MaskGrid layout: one line of unit groups, three bands of boxes
+struct SliceOffsets {
+    uint8_t line[9];
+    uint8_t band[3][9];
+    uint8_t transpose[81];                       // Column-major index of each cell
+};
+
+constexpr SliceOffsets makeSliceOffsets()
+{
+    SliceOffsets offsets = {};
+    for (int k = 0; k < 9; k++)
+    {
+        offsets.line[k] = 9 * k;
+    }
+    for (int g = 0; g < 3; g++)
+    {
+        for (int k = 0; k < 9; k++)
+        {
+            offsets.band[g][k] = 9 * (3 * g + k / 3) + k % 3;
+        }
+    }
+    for (int cell = 0; cell < 81; cell++)
+    {
+        offsets.transpose[cell] = 9 * (cell % 9) + cell / 9;
+    }
+    return offsets;
+}
+
+constexpr SliceOffsets sliceOffsets = makeSliceOffsets();
+
+// Accumulates seen and duplicate masks over the 9 slices at base + offsets[k];
+// lanes 0-8 of seen and dup are valid
+typedef void (*AccumulateFn)(const uint16_t* base, const uint8_t offsets[9], uint16_t* seen, uint16_t* dup);
+
+void accumulateScalar(const uint16_t* base, const uint8_t offsets[9], uint16_t* seen, uint16_t* dup)
+{
+    for (int lane = 0; lane < 9; lane++)
+    {
+        uint16_t s = 0, d = 0;
+        for (int k = 0; k < 9; k++)
+        {
+            uint16_t v = base[offsets[k] + lane];
+            d |= s & v;
+            s |= v;
+        }
+        seen[lane] = s;
+        dup[lane] = d;
+    }
+}
+
+#ifdef SUDOKU_X86
+__attribute__((target("sse2")))
+void accumulateSSE2(const uint16_t* base, const uint8_t offsets[9], uint16_t* seen, uint16_t* dup)
+{
+    __m128i s0 = _mm_setzero_si128(), s1 = _mm_setzero_si128();
+    __m128i d0 = _mm_setzero_si128(), d1 = _mm_setzero_si128();
+    for (int k = 0; k < 9; k++)
+    {
+        const uint16_t* slice = base + offsets[k];
+        __m128i v0 = _mm_loadu_si128((const __m128i*)slice);
+        __m128i v1 = _mm_loadu_si128((const __m128i*)(slice + 8));
+        d0 = _mm_or_si128(d0, _mm_and_si128(s0, v0));
+        d1 = _mm_or_si128(d1, _mm_and_si128(s1, v1));
+        s0 = _mm_or_si128(s0, v0);
+        s1 = _mm_or_si128(s1, v1);
+    }
+    _mm_store_si128((__m128i*)&seen[0], s0);
+    _mm_store_si128((__m128i*)&seen[8], s1);
+    _mm_store_si128((__m128i*)&dup[0], d0);
+    _mm_store_si128((__m128i*)&dup[8], d1);
+}
+
+__attribute__((target("avx2")))
+void accumulateAVX2(const uint16_t* base, const uint8_t offsets[9], uint16_t* seen, uint16_t* dup)
+{
+    __m256i s = _mm256_setzero_si256();
+    __m256i d = _mm256_setzero_si256();
+    for (int k = 0; k < 9; k++)
+    {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(base + offsets[k]));
+        d = _mm256_or_si256(d, _mm256_and_si256(s, v));
+        s = _mm256_or_si256(s, v);
+    }
+    _mm256_store_si256((__m256i*)seen, s);
+    _mm256_store_si256((__m256i*)dup, d);
+}
+#endif
+
+struct Kernel {
+    AccumulateFn accumulate;
+    const char* name;
+};
+
+/**
+ * Picks the widest kernel the running CPU supports
+ */
+Kernel selectKernel()
+{
+#ifdef SUDOKU_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return { accumulateAVX2, "avx2" };
+    if (__builtin_cpu_supports("sse2")) return { accumulateSSE2, "sse2" };
+#endif
+    return { accumulateScalar, "scalar" };
+}
+
+/**
+ * @return Kernel for this CPU, selected on first use so callers running
+ *         during static initialization of other files are safe
+ */
+const Kernel& activeKernel()
+{
+    static const Kernel kernel = selectKernel();
+    return kernel;
+}
+
+/**
+ * Builds both mask layouts in one sequential pass over the grid
+ * @param cells Grid in row-major order, 0 for empty
+ * @param grid [out] Row-major and column-major digit masks, zero-padded
+ */
+void buildMasks(const uint8_t cells[81], MaskGrid& grid)
+{
+    for (int cell = 0; cell < 81; cell++)
+    {
+        uint16_t bit = DIGIT_BIT[cells[cell] & 15];
+        grid.byRow[cell] = bit;
+        grid.byCol[sliceOffsets.transpose[cell]] = bit;
+    }
+    memset(grid.byRow + 81, 0, sizeof(grid.byRow) - 81 * sizeof(uint16_t));
+    memset(grid.byCol + 81, 0, sizeof(grid.byCol) - 81 * sizeof(uint16_t));
+}
+
+/**
+ * Runs the kernel over the columns, rows and the three bands of boxes
+ * @param cells Grid in row-major order, 0 for empty
+ * @param seen [out] Used digits per unit lane: 0-8 columns, 9-17 rows, 18-26 boxes
+ * @param dup [out] Repeated digits per unit lane
+ */
+void scanLanes(const uint8_t cells[81], uint16_t seen[27], uint16_t dup[27])
+{
+    MaskGrid grid;
+    buildMasks(cells, grid);
+
+    AccumulateFn accumulate = activeKernel().accumulate;
+    alignas(32) uint16_t s[LANES];
+    alignas(32) uint16_t d[LANES];
+    accumulate(grid.byRow, sliceOffsets.line, s, d);
+    memcpy(seen, s, 9 * sizeof(uint16_t));
+    memcpy(dup, d, 9 * sizeof(uint16_t));
+    accumulate(grid.byCol, sliceOffsets.line, s, d);
+    memcpy(seen + 9, s, 9 * sizeof(uint16_t));
+    memcpy(dup + 9, d, 9 * sizeof(uint16_t));
+    for (int g = 0; g < 3; g++)
+    {
+        accumulate(grid.byRow, sliceOffsets.band[g], s, d);
+        for (int b = 0; b < 3; b++)
+        {
+            seen[18 + 3 * g + b] = s[3 * b];
+            dup[18 + 3 * g + b] = d[3 * b];
+        }
+    }
+}
+
+}
+
+/**
+ * Computes the used-digit mask of all 27 units in one pass
+ * @param cells Grid in row-major order, 0 for empty
+ * @param scan [out] Row, column and box masks plus conflict flag
+ */
+void scanUnits(const uint8_t cells[81], UnitScan& scan)
+{
+    uint16_t seen[27];
+    uint16_t dup[27];
+    scanLanes(cells, seen, dup);
+
+    uint16_t anyDup = 0;
+    for (int i = 0; i < 9; i++)
+    {
+        scan.colMask[i] = seen[i];
+        scan.rowMask[i] = seen[9 + i];
+        scan.boxMask[i] = seen[18 + i];
+    }
+    for (int lane = 0; lane < 27; lane++)
+    {
+        anyDup |= dup[lane];
+    }
+    scan.conflict = anyDup != 0;
+}
+
+/**
+ * @param cells Grid in row-major order, 0 for empty
+ * @return True if any row, column or box contains a digit twice
+ */
+bool hasConflicts(const uint8_t cells[81])
+{
+    UnitScan scan;
+    scanUnits(cells, scan);
+    return scan.conflict;
+}
+
+/**
+ * Checks a submitted grid in one pass: every unit must hold all nine digits
+ * @param cells Grid in row-major order, 0 for empty
+ * @return True if the grid is completely and correctly filled
+ */
+bool isSolvedGrid(const uint8_t cells[81])
+{
+    uint16_t seen[27];
+    uint16_t dup[27];
+    scanLanes(cells, seen, dup);
+
+    // Nine cells holding all nine digits cannot repeat one, so a full mask
+    // in every unit is both completeness and validity
+    for (int lane = 0; lane < 27; lane++)
+    {
+        if (seen[lane] != ALL_DIGITS) return false;
+    }
+    return true;
+}
+
+/**
+ * Computes the candidate mask of every cell at once
+ * @param cells Grid in row-major order, 0 for empty
+ * @param candidates [out] Digits allowed in each empty cell, 0 for filled cells
+ */
+void computeCandidates(const uint8_t cells[81], uint16_t candidates[81])
+{
+    UnitScan scan;
+    scanUnits(cells, scan);
+    for (int cell = 0; cell < 81; cell++)
+    {
+        const uint8_t* units = sudokuTables.cellUnits[cell];
+        uint16_t used = scan.rowMask[units[0]] | scan.colMask[units[1]] | scan.boxMask[units[2]];
+        candidates[cell] = cells[cell] ? 0 : (~used & ALL_DIGITS);
+    }
+}
+
+/**
+ * @return Name of the kernel selected for this CPU ("avx2", "sse2" or "scalar")
+ */
+const char* simdKernelName()
+{
+    return activeKernel().name;
+}
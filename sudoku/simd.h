@@ -0,0 +1,28 @@
+#ifndef SIMD_H
+#define SIMD_H
+
+#include <cstdint>
+
+// Whole-grid validation and candidate kernels
+// The grid's 16-bit digit masks are stored row-major and column-major, so
+// the nine members of every column, row or box group are nine contiguous
+// vector loads, and vertical OR/AND over them yields each unit's used digits
+// and duplicates at once: one pass for the columns, one for the rows and one
+// per band of boxes. SSE2 and AVX2 variants are picked at startup from the
+// running CPU, with a scalar fallback.
+
+// Result of one scan: used digits and duplicated digits per unit
+struct UnitScan {
+    uint16_t rowMask[9];
+    uint16_t colMask[9];
+    uint16_t boxMask[9];
+    bool conflict;                               // Some unit holds a digit twice
+};
+
+void scanUnits(const uint8_t cells[81], UnitScan& scan);              // Masks and duplicates for all 27 units
+bool hasConflicts(const uint8_t cells[81]);                           // True if any unit repeats a digit
+bool isSolvedGrid(const uint8_t cells[81]);                           // Full grid with no repeats
+void computeCandidates(const uint8_t cells[81], uint16_t candidates[81]); // Allowed digits per empty cell, 0 if filled
+const char* simdKernelName();                                         // Kernel chosen for this CPU
+
+#endif
@@ -0,0 +1,485 @@
+#include <iostream>
+#include <cstring>
+#include <cstdlib>
+#include <chrono>
+#include <climits>
+#include <cstdio>
+#include <memory>
+#include <thread>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "solver.h"
+#include "simd.h"
+#include "grid.h"
+#include "parallel.h"
+using namespace std;
+
+// Size of the stdin read block and of the output buffer
+static const size_t BLOCK_SIZE = 1 << 22;
+
+struct SolveOptions {
+    SolverStrategy strategy = SOLVER_BITMASK;
+    bool checkUnique = false;       // Count to two and report non-unique puzzles
+    bool verify = false;            // Re-check every solution with the grid validator
+    FILE* stats = nullptr;          // Per-puzzle solver stats (-S), nullptr if off
+    int box = 3;                    // Box size (-b): 2, 3, 4 or 5 for 4x4 to 25x25
+    Variant variant = VARIANT_CLASSIC; // 9x9 rule set (-V)
+    long countLimit = 0;            // Print solution counts up to this limit (-c), 0 if off
+    ThreadPool* pool = nullptr;     // Workers sharing each puzzle's search (-j), nullptr if off
+};
+
+struct SolveTotals {
+    long puzzles = 0;
+    long solved = 0;
+    long unsolvable = 0;
+    long multiple = 0;
+    long skipped = 0;               // Lines that are not puzzles
+    long invalid = 0;               // Solutions rejected by verification
+    SolverStats stats = {};         // Sum over all puzzles
+};
+
+// Buffered writer that flushes with one write() per full buffer
+class OutputBuffer {
+private:
+    char* buffer;
+    size_t used;
+
+public:
+    OutputBuffer() : buffer(new char[BLOCK_SIZE]), used(0) {}
+    ~OutputBuffer() { flush(); delete[] buffer; }
+
+    char* reserve(size_t bytes)
+    {
+        if (used + bytes > BLOCK_SIZE) flush();
+        char* out = buffer + used;
+        used += bytes;
+        return out;
+    }
+
+    void flush()
+    {
+        size_t done = 0;
+        while (done < used)
+        {
+            ssize_t n = write(STDOUT_FILENO, buffer + done, used - done);
+            if (n <= 0) break;
+            done += n;
+        }
+        used = 0;
+    }
+};
+
+/**
+ * Appends a solution count line (-c)
+ * @param out Output buffer
+ * @param count Solutions found
+ */
+static void writeCount(OutputBuffer& out, long count)
+{
+    char text[24];
+    int length = snprintf(text, sizeof(text), "%ld\n", count);
+    memcpy(out.reserve(length), text, length);
+}
+
+/**
+ * Parses a puzzle directly from the input bytes, no copies
+ * Accepts '1'-'9' for clues and '0' or '.' for empty cells; anything after
+ * the 81st character (e.g. ",solution") is ignored
+ * @param line Start of the line
+ * @param length Line length without the newline
+ * @param cells [out] Parsed puzzle
+ * @return True if the line starts with a puzzle, false otherwise
+ */
+static bool parseLine(const char* line, size_t length, uint8_t cells[81])
+{
+    if (length < 81) return false;
+    if (length > 81 && line[81] >= '0' && line[81] <= '9') return false;
+    for (int i = 0; i < 81; i++)
+    {
+        char ch = line[i];
+        if (ch >= '1' && ch <= '9') cells[i] = ch - '0';
+        else if (ch == '0' || ch == '.') cells[i] = 0;
+        else return false;
+    }
+    return true;
+}
+
+/**
+ * Checks that a solution is a valid full grid that keeps every given
+ * @param puzzle Puzzle that was solved
+ * @param solution Solution to check
+ * @return True if the solution is correct
+ */
+static bool verifySolution(const uint8_t puzzle[81], const uint8_t solution[81])
+{
+    for (int i = 0; i < 81; i++)
+    {
+        if (puzzle[i] != 0 && puzzle[i] != solution[i]) return false;
+    }
+    return isSolvedGrid(solution);
+}
+
+/**
+ * Solves one line and appends its result; an empty line marks a puzzle
+ * without a solution so output lines stay aligned with input puzzles
+ */
+static void solveLine(const char* line, size_t length, const SolveOptions& options, SolveTotals& totals, OutputBuffer& out)
+{
+    uint8_t grid[81];
+    uint8_t solution[81];
+    if (!parseLine(line, length, grid))
+    {
+        totals.skipped++;
+        return;
+    }
+
+    totals.puzzles++;
+    SolverStats stats;
+    int limit = options.countLimit ? (int)min<long>(options.countLimit, INT_MAX) : options.checkUnique ? 2 : 1;
+    int count = countSolutionsWith(options.strategy, grid, limit, solution, &stats);
+    addStats(totals.stats, stats);
+    if (options.stats) printStatsLine(options.stats, totals.puzzles, stats);
+    if (options.countLimit) writeCount(out, count);
+    if (count == 0)
+    {
+        totals.unsolvable++;
+        if (!options.countLimit) *out.reserve(1) = '\n';
+        return;
+    }
+    totals.solved++;
+    if (count > 1) totals.multiple++;
+    if (options.countLimit) return;
+    if (options.verify && !verifySolution(grid, solution)) totals.invalid++;
+
+    char* text = out.reserve(82);
+    for (int i = 0; i < 81; i++)
+    {
+        text[i] = '0' + solution[i];
+    }
+    text[81] = '\n';
+}
+
+/**
+ * Solves one line of a non-9x9 or variant puzzle with the generic
+ * GridSolver, or of any size with the parallel search (-j)
+ * Same output rules as solveLine, with digits above 9 written as letters
+ */
+template <int BOX, typename Rules = ClassicRules<BOX> >
+static void solveGridLine(const char* line, size_t length, const SolveOptions& options, SolveTotals& totals, OutputBuffer& out)
+{
+    typedef GridTraits<BOX> T;
+    static thread_local GridSolver<BOX, Rules> solver;
+    uint8_t grid[T::CELLS];
+    uint8_t solution[T::CELLS];
+    if (!parseGrid<BOX>(line, length, grid) || (length > (size_t)T::CELLS && charDigit(line[T::CELLS]) >= 0))
+    {
+        totals.skipped++;
+        return;
+    }
+
+    totals.puzzles++;
+    long limit = options.countLimit ? options.countLimit : options.checkUnique ? 2 : 1;
+    long count;
+    SolverStats stats = {};
+    if (options.pool)
+    {
+        static unique_ptr<ParallelSolver<BOX, Rules> > parallel(new ParallelSolver<BOX, Rules>(*options.pool));
+        count = parallel->countSolutions(grid, limit, solution, &stats);
+    }
+    else
+    {
+        solver.resetStats();
+        count = solver.load(grid) ? solver.countSolutions((int)min<long>(limit, INT_MAX)) : 0;
+        solver.getSolution(solution);
+        stats = solver.getStats();
+    }
+    addStats(totals.stats, stats);
+    if (options.stats) printStatsLine(options.stats, totals.puzzles, stats);
+    if (options.countLimit) writeCount(out, count);
+    if (count == 0)
+    {
+        totals.unsolvable++;
+        if (!options.countLimit) *out.reserve(1) = '\n';
+        return;
+    }
+    totals.solved++;
+    if (count > 1) totals.multiple++;
+    if (options.countLimit) return;
+    if (options.verify)
+    {
+        bool keepsGivens = true;
+        for (int i = 0; i < T::CELLS; i++)
+        {
+            if (grid[i] != 0 && grid[i] != solution[i]) keepsGivens = false;
+        }
+        if (!keepsGivens || !isSolvedGridOf<BOX, Rules>(solution)) totals.invalid++;
+    }
+
+    char* text = out.reserve(T::CELLS + 1);
+    formatGrid<BOX>(solution, text);
+    text[T::CELLS] = '\n';
+}
+
+/**
+ * Solves every complete line in a block of input
+ * @param data Start of the block
+ * @param size Block size in bytes
+ * @param final True if no more input follows, so a trailing line without a
+ *              newline is complete
+ * @return Bytes consumed; the rest is a partial line to carry over
+ */
+static size_t processBlock(const char* data, size_t size, bool final, const SolveOptions& options, SolveTotals& totals, OutputBuffer& out)
+{
+    size_t start = 0;
+    while (start < size)
+    {
+        const char* newline = (const char*)memchr(data + start, '\n', size - start);
+        if (!newline && !final) break;
+
+        size_t end = newline ? newline - data : size;
+        size_t length = end - start;
+        if (length > 0 && data[end - 1] == '\r') length--;
+        if (length > 0 && data[start] != '#')
+        {
+            switch (options.box)
+            {
+                case 2: solveGridLine<2>(data + start, length, options, totals, out); break;
+                case 4: solveGridLine<4>(data + start, length, options, totals, out); break;
+                case 5: solveGridLine<5>(data + start, length, options, totals, out); break;
+                default:
+                    switch (options.variant)
+                    {
+                        case VARIANT_DIAGONAL: solveGridLine<3, DiagonalRules>(data + start, length, options, totals, out); break;
+                        case VARIANT_WINDOKU: solveGridLine<3, WindokuRules>(data + start, length, options, totals, out); break;
+                        case VARIANT_ANTIKNIGHT: solveGridLine<3, AntiKnightRules>(data + start, length, options, totals, out); break;
+                        default:
+                            if (options.pool) solveGridLine<3>(data + start, length, options, totals, out);
+                            else solveLine(data + start, length, options, totals, out);
+                            break;
+                    }
+                    break;
+            }
+        }
+        start = newline ? end + 1 : size;
+    }
+    return start;
+}
+
+/**
+ * Solves a file by mapping it into memory
+ * @return False if the file could not be opened
+ */
+static bool solveFile(const char* path, const SolveOptions& options, SolveTotals& totals, OutputBuffer& out)
+{
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat info;
+    if (fstat(fd, &info) != 0)
+    {
+        close(fd);
+        return false;
+    }
+    if (info.st_size == 0)
+    {
+        close(fd);
+        return true;
+    }
+
+    void* mapped = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED) return false;
+    madvise(mapped, info.st_size, MADV_SEQUENTIAL);
+    processBlock((const char*)mapped, info.st_size, true, options, totals, out);
+    munmap(mapped, info.st_size);
+    return true;
+}
+
+/**
+ * Solves standard input with large block reads, carrying partial lines over
+ */
+static void solveStdin(const SolveOptions& options, SolveTotals& totals, OutputBuffer& out)
+{
+    char* buffer = new char[BLOCK_SIZE];
+    size_t kept = 0;
+    bool discarding = false;  // Inside an over-long line, dropped up to its newline
+    while (true)
+    {
+        ssize_t n = read(STDIN_FILENO, buffer + kept, BLOCK_SIZE - kept);
+        bool final = n <= 0;
+        size_t size = kept + (n > 0 ? n : 0);
+        if (discarding)
+        {
+            char* newline = (char*)memchr(buffer, '\n', size);
+            size_t rest = newline ? buffer + size - (newline + 1) : 0;
+            if (newline) memmove(buffer, newline + 1, rest);
+            size = rest;
+            discarding = !newline;
+        }
+        size_t used = processBlock(buffer, size, final, options, totals, out);
+        if (final) break;
+
+        kept = size - used;
+        if (kept == BLOCK_SIZE)
+        {
+            kept = 0;  // A single line longer than the block cannot be a puzzle
+            discarding = true;
+            totals.skipped++;
+        }
+        memmove(buffer, buffer + used, kept);
+    }
+    delete[] buffer;
+}
+
+/**
+ * Batch solver entry point
+ * Usage: sudoku-solve [-s STRATEGY] [-b BOX] [-V VARIANT] [-u] [-v] [-c LIMIT] [-j THREADS] [-S STATSFILE] [FILE...]
+ * Reads 81-character puzzle lines from the files (or stdin) and writes one
+ * 81-digit solution line per puzzle to stdout; a summary goes to stderr.
+ * With -b 2, 4 or 5, lines hold 16, 256 or 625 cells and are solved by the
+ * generic GridSolver, as are 9x9 variants (-V diagonal, windoku or
+ * antiknight). -c writes solution counts instead; -j spreads each puzzle's
+ * search over THREADS workers. -s picks the engine of the sequential 9x9
+ * classic path only and is rejected together with -j, -b or -V.
+ */
+int main(int argc, char* argv[])
+{
+    SolveOptions options;
+    int threads = 0;
+    bool strategyGiven = false;                  // -s only applies to the sequential 9x9 path
+    int firstFile = argc;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "-s") == 0 && i + 1 < argc)
+        {
+            if (!parseStrategy(argv[++i], options.strategy))
+            {
+                cerr << "Unknown strategy: " << argv[i] << "\n";
+                return 1;
+            }
+            strategyGiven = true;
+        }
+        else if (strcmp(argv[i], "-b") == 0 && i + 1 < argc)
+        {
+            options.box = atoi(argv[++i]);
+            if (options.box < 2 || options.box > 5)
+            {
+                cerr << "Box size must be 2, 3, 4 or 5\n";
+                return 1;
+            }
+        }
+        else if (strcmp(argv[i], "-V") == 0 && i + 1 < argc)
+        {
+            if (!parseVariant(argv[++i], options.variant))
+            {
+                cerr << "Unknown variant: " << argv[i] << "\n";
+                return 1;
+            }
+        }
+        else if (strcmp(argv[i], "-u") == 0)
+        {
+            options.checkUnique = true;
+        }
+        else if (strcmp(argv[i], "-v") == 0)
+        {
+            options.verify = true;
+        }
+        else if (strcmp(argv[i], "-c") == 0 && i + 1 < argc)
+        {
+            options.countLimit = atol(argv[++i]);
+            if (options.countLimit < 1)
+            {
+                cerr << "Count limit must be at least 1\n";
+                return 1;
+            }
+        }
+        else if (strcmp(argv[i], "-j") == 0 && i + 1 < argc)
+        {
+            threads = atoi(argv[++i]);
+            if (threads < 1) threads = max(1u, thread::hardware_concurrency());
+        }
+        else if (strcmp(argv[i], "-S") == 0 && i + 1 < argc)
+        {
+            options.stats = fopen(argv[++i], "w");
+            if (!options.stats)
+            {
+                cerr << "Error: Could not open " << argv[i] << "\n";
+                return 1;
+            }
+            if (!statsEnabled()) cerr << "Warning: built without SUDOKU_STATS (make STATS=1), counters will be zero\n";
+            printStatsHeader(options.stats);
+        }
+        else if (argv[i][0] == '-' && argv[i][1] != '\0')
+        {
+            cerr << "Usage: sudoku-solve [-s backtrack|bitmask|dlx] [-b 2|3|4|5] [-u] [-v] [-c LIMIT] [-j THREADS]\n"
+                 << "                    [-V classic|diagonal|windoku|antiknight] [-S STATSFILE] [FILE...]\n"
+                 << "  -V VARIANT  9x9 rule set: X-Sudoku diagonals, Windoku windows or anti-knight\n"
+                 << "  -c LIMIT    print the number of solutions, counting up to LIMIT\n"
+                 << "  -j THREADS  split each puzzle's search over THREADS workers (0 = all cores)\n"
+                 << "  -s STRATEGY engine for 9x9 classic puzzles; not combinable with -j, -b or -V\n";
+            return 1;
+        }
+        else
+        {
+            firstFile = i;
+            break;
+        }
+    }
+
+    if (options.variant != VARIANT_CLASSIC && options.box != 3)
+    {
+        cerr << "Variants are 9x9 only\n";
+        return 1;
+    }
+    if (strategyGiven && (threads > 0 || options.box != 3 || options.variant != VARIANT_CLASSIC))
+    {
+        cerr << "-s cannot be combined with -j, -b or -V, which use their own solvers\n";
+        return 1;
+    }
+
+    unique_ptr<ThreadPool> pool(threads > 0 ? new ThreadPool(threads) : nullptr);
+    options.pool = pool.get();
+
+    if (statsEnabled()) statsTicksToNs(0);  // Calibrate the timer outside the timed run
+    SolveTotals totals;
+    auto start = chrono::steady_clock::now();
+    {
+        OutputBuffer out;
+        if (firstFile == argc)
+        {
+            solveStdin(options, totals, out);
+        }
+        for (int i = firstFile; i < argc; i++)
+        {
+            if (strcmp(argv[i], "-") == 0)
+            {
+                solveStdin(options, totals, out);
+            }
+            else if (!solveFile(argv[i], options, totals, out))
+            {
+                cerr << "Error: Could not read " << argv[i] << "\n";
+                return 1;
+            }
+        }
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    cerr << totals.puzzles << " puzzles, " << totals.solved << " solved, " << totals.unsolvable << " unsolvable";
+    if (options.checkUnique) cerr << ", " << totals.multiple << " with multiple solutions";
+    if (options.verify) cerr << ", " << totals.invalid << " failed verification (" << simdKernelName() << ")";
+    if (totals.skipped > 0) cerr << ", " << totals.skipped << " lines skipped";
+    cerr << " in " << seconds << " s (" << (long)(totals.puzzles / (seconds > 0 ? seconds : 1)) << " puzzles/sec, "
+         << (options.pool ? "parallel" : options.box != 3 ? "grid" : options.variant != VARIANT_CLASSIC ? variantName(options.variant)
+             : strategyName(options.strategy)) << ")\n";
+    if (statsEnabled())
+    {
+        cerr << "stats: " << totals.stats.nodes << " nodes, " << totals.stats.guesses << " guesses, "
+             << totals.stats.backtracks << " backtracks, " << totals.stats.propagations << " propagations, "
+             << totals.stats.checks << " checks, max depth " << totals.stats.maxDepth << ", "
+             << statsTicksToNs(totals.stats.ticks[PHASE_SOLVE]) / 1e6 << " ms solving\n";
+    }
+    if (options.stats) fclose(options.stats);
+    return 0;
+}
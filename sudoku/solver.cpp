@@ -0,0 +1,257 @@
+#include "solver.h"
+#include "dlx.h"
+#include <cstring>
+
+/**
+ * BacktrackSolver constructor - Starts from an empty grid
+ */
+BacktrackSolver::BacktrackSolver()
+{
+    memset(grid, 0, sizeof(grid));
+    memset(solution, 0, sizeof(solution));
+    solutionsFound = 0;
+    solutionLimit = 1;
+    ::resetStats(stats);
+}
+
+/**
+ * Loads a puzzle into the solver
+ * @param puzzle Puzzle in row-major order with 0 for empty cells
+ * @return False if two givens conflict, true otherwise
+ */
+bool BacktrackSolver::load(const uint8_t puzzle[81])
+{
+    memset(grid, 0, sizeof(grid));
+    for (int row = 0; row < 9; row++)
+    {
+        for (int col = 0; col < 9; col++)
+        {
+            int num = puzzle[row * 9 + col];
+            if (num == 0) continue;
+            if (num < 1 || num > 9 || !isValidPlacement(row, col, num))
+            {
+                return false;
+            }
+            grid[row][col] = num;
+        }
+    }
+    return true;
+}
+
+/**
+ * Finds the next empty cell in row-major order
+ * @param row [out] Reference to store row index of empty cell
+ * @param col [out] Reference to store column index of empty cell
+ * @return True if empty cell found, false if board is complete
+ */
+bool BacktrackSolver::findEmptyCell(int& row, int& col) const
+{
+    for (row = 0; row < 9; row++)
+    {
+        for (col = 0; col < 9; col++)
+        {
+            if (grid[row][col] == 0)
+            {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+/**
+ * Checks if a number can be placed at given position following Sudoku rules
+ * @param row Row index (0-8)
+ * @param col Column index (0-8)
+ * @param num Number to check (1-9)
+ * @return True if placement is valid, false otherwise
+ */
+bool BacktrackSolver::isValidPlacement(int row, int col, int num) const
+{
+    // Check the 20 cells sharing a row, column or box
+    const int* cells = &grid[0][0];
+    const uint8_t* peers = sudokuTables.peers[Board::index(row, col)];
+    for (int i = 0; i < 20; i++)
+    {
+        if (cells[peers[i]] == num)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Recursive backtracking over digits 1-9 in the first empty cell
+ * @return True once the solution limit is reached, false to keep searching
+ */
+bool BacktrackSolver::search()
+{
+    STATS_INC(stats, nodes);
+    int row, col;
+    if (!findEmptyCell(row, col))
+    {
+        if (solutionsFound == 0)
+        {
+            memcpy(solution, grid, sizeof(solution));
+        }
+        solutionsFound++;
+        return solutionsFound >= solutionLimit;
+    }
+
+    // Try numbers 1-9 in current cell
+    for (int num = 1; num <= 9; num++)
+    {
+        bool valid;
+        {
+            STATS_TIMER(stats, PHASE_VALIDATE);
+            STATS_INC(stats, checks);
+            valid = isValidPlacement(row, col, num);
+        }
+        if (valid)
+        {
+            grid[row][col] = num;               // Tentative placement
+            STATS_INC(stats, guesses);
+            STATS_ENTER(stats);
+            bool done = search();               // Recurse with this placement
+            STATS_LEAVE(stats);
+            grid[row][col] = 0;                 // Backtrack
+            if (done) return true;
+            STATS_INC(stats, backtracks);
+        }
+    }
+    return false;  // Trigger backtracking
+}
+
+/**
+ * Solves the loaded puzzle
+ * @return True if a solution was found, false if unsolvable
+ */
+bool BacktrackSolver::solve()
+{
+    return countSolutions(1) == 1;
+}
+
+/**
+ * Counts solutions of the loaded puzzle, stopping early at the limit
+ * @param limit Maximum number of solutions to look for
+ * @return Number of solutions found (at most limit)
+ */
+int BacktrackSolver::countSolutions(int limit)
+{
+    STATS_TIMER(stats, PHASE_SOLVE);
+    solutionsFound = 0;
+    solutionLimit = limit;
+    search();
+    return solutionsFound;
+}
+
+/**
+ * Copies the first solution found by the last solve or count
+ * @param out [out] Receives the solved grid in row-major order
+ */
+void BacktrackSolver::getSolution(uint8_t out[81]) const
+{
+    for (int cell = 0; cell < 81; cell++)
+    {
+        out[cell] = solution[cell / 9][cell % 9];
+    }
+}
+
+/**
+ * @return Counters accumulated since the last resetStats (zero unless built
+ *         with SUDOKU_STATS)
+ */
+const SolverStats& BacktrackSolver::getStats() const
+{
+    return stats;
+}
+
+/**
+ * Zeroes the counters and phase timers
+ */
+void BacktrackSolver::resetStats()
+{
+    ::resetStats(stats);
+}
+
+/**
+ * @param strategy Solver engine
+ * @return Short name used on the command line and in reports
+ */
+const char* strategyName(SolverStrategy strategy)
+{
+    switch (strategy)
+    {
+        case SOLVER_BACKTRACK: return "backtrack";
+        case SOLVER_BITMASK:   return "bitmask";
+        case SOLVER_DLX:       return "dlx";
+    }
+    return "unknown";
+}
+
+/**
+ * Parses a strategy name as printed by strategyName
+ * @param name Name to parse
+ * @param strategy [out] Parsed strategy
+ * @return True if the name is known, false otherwise
+ */
+bool parseStrategy(const char* name, SolverStrategy& strategy)
+{
+    const SolverStrategy all[] = { SOLVER_BACKTRACK, SOLVER_BITMASK, SOLVER_DLX };
+    for (SolverStrategy candidate : all)
+    {
+        if (strcmp(name, strategyName(candidate)) == 0)
+        {
+            strategy = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+namespace {
+
+template <typename Solver>
+int countWith(Solver& solver, const uint8_t puzzle[81], int limit, uint8_t solution[81], SolverStats* stats)
+{
+    solver.resetStats();
+    int count = solver.load(puzzle) ? solver.countSolutions(limit) : 0;
+    if (count > 0) solver.getSolution(solution);
+    if (stats) *stats = solver.getStats();
+    return count;
+}
+
+}
+
+/**
+ * Counts solutions of a puzzle with the chosen engine
+ * @param strategy Engine to use
+ * @param puzzle Puzzle in row-major order with 0 for empty cells
+ * @param limit Maximum number of solutions to look for
+ * @param solution [out] First solution found, untouched if none
+ * @param stats [out] Engine counters for this puzzle, if not nullptr
+ * @return Number of solutions found (at most limit), 0 if givens conflict
+ */
+int countSolutionsWith(SolverStrategy strategy, const uint8_t puzzle[81], int limit, uint8_t solution[81], SolverStats* stats)
+{
+    switch (strategy)
+    {
+        case SOLVER_BACKTRACK:
+        {
+            BacktrackSolver solver;
+            return countWith(solver, puzzle, limit, solution, stats);
+        }
+        case SOLVER_DLX:
+        {
+            static thread_local DLXSolver solver;  // Reuses the linked matrix across calls
+            return countWith(solver, puzzle, limit, solution, stats);
+        }
+        case SOLVER_BITMASK:
+        default:
+        {
+            SudokuSolver solver;
+            return countWith(solver, puzzle, limit, solution, stats);
+        }
+    }
+}
@@ -0,0 +1,51 @@
+#ifndef SOLVER_H
+#define SOLVER_H
+
+#include <cstdint>
+#include "rng.h"
+#include "board.h"
+#include "grid.h"
+#include "stats.h"
+
+// Constraint-propagation solver for the 9x9 game: the box-size-3 instance
+// of GridSolver (grid.h) under the classic rules, which tracks used digits
+// per row, column and box as 9-bit masks (bit d-1 set means digit d is
+// already placed in that unit)
+typedef GridSolver<3> SudokuSolver;
+
+// Plain digit-ordered recursive backtracker, kept as the reference strategy
+class BacktrackSolver {
+private:
+    int grid[9][9];
+    int solution[9][9];
+    int solutionsFound;
+    int solutionLimit;
+    SolverStats stats;
+
+    bool findEmptyCell(int& row, int& col) const;     // Finds next empty cell coordinates
+    bool isValidPlacement(int row, int col, int num) const; // Checks if number fits in cell
+    bool search();                                    // Recursive backtracking
+
+public:
+    BacktrackSolver();
+    bool load(const uint8_t puzzle[81]);         // Loads givens, false on conflict
+    bool solve();                                // Finds one solution
+    int countSolutions(int limit);               // Counts solutions up to limit
+    void getSolution(uint8_t out[81]) const;     // Copies last found solution
+    const SolverStats& getStats() const;         // Counters since the last resetStats
+    void resetStats();                           // Zeroes the counters
+};
+
+// Solver engines selectable at runtime
+enum SolverStrategy {
+    SOLVER_BACKTRACK,                            // BacktrackSolver
+    SOLVER_BITMASK,                              // SudokuSolver
+    SOLVER_DLX                                   // DLXSolver
+};
+
+const char* strategyName(SolverStrategy strategy);              // Name used in CLIs and reports
+bool parseStrategy(const char* name, SolverStrategy& strategy); // Inverse of strategyName
+int countSolutionsWith(SolverStrategy strategy, const uint8_t puzzle[81], int limit, uint8_t solution[81],
+                       SolverStats* stats = nullptr);  // Runs one engine on a puzzle, optionally reporting its stats
+
+#endif
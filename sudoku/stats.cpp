@@ -0,0 +1,114 @@
+#include "stats.h"
+#include <chrono>
+#include <thread>
+
+/**
+ * Zeroes all counters and timers
+ * @param stats Stats to clear
+ */
+void resetStats(SolverStats& stats)
+{
+    memset(&stats, 0, sizeof(stats));
+}
+
+/**
+ * Accumulates one set of stats into a total; depths take the maximum
+ * @param total [in,out] Running total
+ * @param stats Stats to add
+ */
+void addStats(SolverStats& total, const SolverStats& stats)
+{
+    total.nodes += stats.nodes;
+    total.guesses += stats.guesses;
+    total.backtracks += stats.backtracks;
+    total.propagations += stats.propagations;
+    total.checks += stats.checks;
+    if (stats.maxDepth > total.maxDepth) total.maxDepth = stats.maxDepth;
+    for (int phase = 0; phase < PHASE_COUNT; phase++)
+    {
+        total.ticks[phase] += stats.ticks[phase];
+    }
+}
+
+/**
+ * Converts timer ticks to nanoseconds. With RDTSC the tick rate is
+ * measured once against steady_clock over a short sleep.
+ * @param ticks Ticks from statsNow() differences
+ * @return Nanoseconds
+ */
+double statsTicksToNs(uint64_t ticks)
+{
+#if defined(SUDOKU_STATS) && (defined(__x86_64__) || defined(__i386__))
+    static const double nsPerTick = []() {
+        auto start = std::chrono::steady_clock::now();
+        uint64_t begin = statsNow();
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        uint64_t end = statsNow();
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        return ns / (double)(end - begin);
+    }();
+    return ticks * nsPerTick;
+#else
+    return (double)ticks;
+#endif
+}
+
+/**
+ * @param phase Phase to name
+ * @return Short name used in report columns
+ */
+const char* statsPhaseName(StatsPhase phase)
+{
+    switch (phase)
+    {
+        case PHASE_SOLVE:     return "solve";
+        case PHASE_PROPAGATE: return "propagate";
+        case PHASE_VALIDATE:  return "validate";
+        default:              break;
+    }
+    return "unknown";
+}
+
+/**
+ * Prints the column names matching printStatsLine
+ * @param out Destination
+ */
+void printStatsHeader(FILE* out)
+{
+    fprintf(out, "puzzle\tnodes\tguesses\tbacktracks\tpropagations\tchecks\tmax_depth");
+    for (int phase = 0; phase < PHASE_COUNT; phase++)
+    {
+        fprintf(out, "\t%s_ns", statsPhaseName((StatsPhase)phase));
+    }
+    fprintf(out, "\n");
+}
+
+/**
+ * Prints one puzzle's stats as a tab-separated row
+ * @param out Destination
+ * @param index Puzzle number
+ * @param stats Stats to print
+ */
+void printStatsLine(FILE* out, long index, const SolverStats& stats)
+{
+    fprintf(out, "%ld\t%llu\t%llu\t%llu\t%llu\t%llu\t%u", index, (unsigned long long)stats.nodes,
+            (unsigned long long)stats.guesses, (unsigned long long)stats.backtracks,
+            (unsigned long long)stats.propagations, (unsigned long long)stats.checks, stats.maxDepth);
+    for (int phase = 0; phase < PHASE_COUNT; phase++)
+    {
+        fprintf(out, "\t%.0f", statsTicksToNs(stats.ticks[phase]));
+    }
+    fprintf(out, "\n");
+}
+
+/**
+ * @return True if the counters and timers were compiled in
+ */
+bool statsEnabled()
+{
+#ifdef SUDOKU_STATS
+    return true;
+#else
+    return false;
+#endif
+}
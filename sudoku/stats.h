@@ -0,0 +1,83 @@
+#ifndef STATS_H
+#define STATS_H
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+// Hot-path instrumentation for the solvers. Counters and phase timers are
+// only compiled in when SUDOKU_STATS is defined (make STATS=1); otherwise
+// the STATS_* macros expand to nothing and every SolverStats reads as zero.
+
+// Timed phases; they nest, so PHASE_SOLVE includes the others
+enum StatsPhase {
+    PHASE_SOLVE,                                 // Whole countSolutions call
+    PHASE_PROPAGATE,                             // Singles propagation (bitmask solver)
+    PHASE_VALIDATE,                              // Placement checks (backtracker)
+    PHASE_COUNT
+};
+
+// Per-puzzle solver counters
+struct SolverStats {
+    uint64_t nodes;                              // Search calls (DLX: columns chosen)
+    uint64_t guesses;                            // Branch placements tried
+    uint64_t backtracks;                         // Branches abandoned or undone
+    uint64_t propagations;                       // Digits forced by singles
+    uint64_t checks;                             // Placement validity checks
+    uint32_t depth;                              // Current recursion depth
+    uint32_t maxDepth;                           // Deepest recursion reached
+    uint64_t ticks[PHASE_COUNT];                 // Time per phase in statsNow() ticks
+};
+
+void resetStats(SolverStats& stats);                          // Zeroes all counters
+void addStats(SolverStats& total, const SolverStats& stats);  // Accumulates counters and times
+double statsTicksToNs(uint64_t ticks);                        // Converts timer ticks to nanoseconds
+const char* statsPhaseName(StatsPhase phase);                 // Name used in reports
+void printStatsHeader(FILE* out);                             // Column names for printStatsLine
+void printStatsLine(FILE* out, long index, const SolverStats& stats); // One tab-separated row
+bool statsEnabled();                                          // True if built with SUDOKU_STATS
+
+#ifdef SUDOKU_STATS
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+inline uint64_t statsNow() { return __rdtsc(); }
+#else
+#include <chrono>
+inline uint64_t statsNow()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+#endif
+
+// Adds the lifetime of the scope to one phase
+class StatsTimer {
+private:
+    SolverStats& stats;
+    StatsPhase phase;
+    uint64_t start;
+
+public:
+    StatsTimer(SolverStats& s, StatsPhase p) : stats(s), phase(p), start(statsNow()) {}
+    ~StatsTimer() { stats.ticks[phase] += statsNow() - start; }
+};
+
+#define STATS_CONCAT2(a, b) a##b
+#define STATS_CONCAT(a, b) STATS_CONCAT2(a, b)
+#define STATS_INC(stats, field) ((stats).field++)
+#define STATS_ADD(stats, field, n) ((stats).field += (n))
+#define STATS_ENTER(stats) do { if (++(stats).depth > (stats).maxDepth) (stats).maxDepth = (stats).depth; } while (0)
+#define STATS_LEAVE(stats) ((stats).depth--)
+#define STATS_TIMER(stats, phase) StatsTimer STATS_CONCAT(statsTimer, __LINE__)(stats, phase)
+
+#else
+
+#define STATS_INC(stats, field) ((void)0)
+#define STATS_ADD(stats, field, n) ((void)0)
+#define STATS_ENTER(stats) ((void)0)
+#define STATS_LEAVE(stats) ((void)0)
+#define STATS_TIMER(stats, phase) ((void)0)
+
+#endif
+
+#endif
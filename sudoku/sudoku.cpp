@@ -1,175 +1,159 @@
 #include "sudoku.h"
+#include <chrono>
+#include <random>
+#include "simd.h"
+#include "savestore.h"
+#include "journal.h"
 using namespace std;
 
-#define FG_GREEN   "\033[32m"
-#define FG_BLUE    "\033[34m"
-#define FG_MAGENTA "\033[35m"
-#define FG_CYAN    "\033[36m"
-#define BOLD       "\033[1m"
-#define RESET      "\033[0m"
-
 /**
- * SudokuGame constructor - Initializes a new Sudoku game
- * Clears all board data, resets game state, and generates a new puzzle
+ * @return This thread's puzzle generator, run on each game's own engine state
  */
-SudokuGame::SudokuGame() 
+static PuzzleGenerator& threadGenerator()
 {
-    memset(data.board, 0, sizeof(data.board));       // Clear player board
-    memset(data.fixed, false, sizeof(data.fixed));   // Reset fixed cell flags
-    memset(data.solution, 0, sizeof(data.solution)); // Clear solution board
-    data.hintsUsed = 0;                             // Reset hint counter
-    data.wrongAttempts = 0;                         // Reset wrong attempts
-    generateSudoku();                               // Generate new puzzle
+    thread_local PuzzleGenerator generator;
+    return generator;
 }
 
 /**
- * Finds the next empty cell in the solution board
- * @param row [out] Reference to store row index of empty cell
- * @param col [out] Reference to store column index of empty cell
- * @return True if empty cell found, false if board is complete
+ * SudokuGame constructor - Initializes a new Sudoku game
+ * Seeds from the random device and clock so every game differs
  */
-bool SudokuGame::findEmptyCell(int& row, int& col) 
+SudokuGame::SudokuGame() 
 {
-    for (row = 0; row < 9; row++) 
-    {
-        for (col = 0; col < 9; col++) 
-        {
-            if (data.solution[row][col] == 0) 
-            {
-                return true;
-            }
-        }
-    }
-    return false;
+    random_device device;
+    uint64_t entropy = ((uint64_t)device() << 32) ^ device();
+    reset(entropy ^ (uint64_t)chrono::steady_clock::now().time_since_epoch().count());
 }
 
 /**
- * Checks if a number can be placed at given position following Sudoku rules
- * @param row Row index (0-8)
- * @param col Column index (0-8)
- * @param num Number to check (1-9)
- * @return True if placement is valid, false otherwise
+ * SudokuGame constructor - Initializes a reproducible Sudoku game
+ * @param seed Same seed always gives the same puzzle
  */
-bool SudokuGame::isValidPlacement(int row, int col, int num) 
+SudokuGame::SudokuGame(uint64_t seed) 
 {
-    // Check row and column for duplicates
-    for (int i = 0; i < 9; i++) 
-    {
-        if (data.solution[row][i] == num || data.solution[i][col] == num) 
-        {
-            return false;
-        }
-    }
-
-    // Check 3x3 box for duplicates
-    int boxRow = row - row % 3;
-    int boxCol = col - col % 3;
-    for (int i = 0; i < 3; i++) 
-    {
-        for (int j = 0; j < 3; j++) 
-        {
-            if (data.solution[boxRow + i][boxCol + j] == num) 
-            {
-                return false;
-            }
-        }
-    }
-    return true;
+    reset(seed);
 }
 
 /**
- * Recursive backtracking solver for Sudoku puzzle
- * @return True if solution found, false if unsolvable
+ * SudokuGame constructor - Starts a game on a pre-generated puzzle
+ * No generation runs; the game is the one SudokuGame(puzzle.seed) builds
+ * @param pooled Puzzle, solution and seed, e.g. from a PuzzlePool
  */
-bool SudokuGame::solveSudoku() 
+SudokuGame::SudokuGame(const PooledPuzzle& pooled) 
 {
-    int row, col;
-    if (!findEmptyCell(row, col)) return true;  // Base case: board complete
-
-    // Try numbers 1-9 in current cell
-    for (int num = 1; num <= 9; num++) 
-    {
-        if (isValidPlacement(row, col, num)) 
-        {
-            data.solution[row][col] = num;      // Tentative placement
-            if (solveSudoku()) return true;     // Recurse with this placement
-            data.solution[row][col] = 0;        // Backtrack if solution fails
-        }
-    }
-    return false;  // Trigger backtracking
+    data.hintsUsed = 0;
+    data.wrongAttempts = 0;
+    data.seed = pooled.seed;
+    rng.reseed(pooled.seed);
+    ::resetStats(stats);
+    journal = nullptr;
+    memcpy(data.solution, pooled.solution, sizeof(data.solution));
+    setPuzzle(pooled.puzzle, pooled.difficulty);
 }
 
 /**
- * Generates a complete Sudoku solution
+ * Clears all board data, resets game state, and generates a new puzzle
+ * @param seed Seed for the puzzle generator
  */
-void SudokuGame::generateSolution() 
+void SudokuGame::reset(uint64_t seed) 
 {
-    solveSudoku();
+    data.board.clear();                              // Clear player board and fixed flags
+    memset(data.solution, 0, sizeof(data.solution)); // Clear solution board
+    data.hintsUsed = 0;                             // Reset hint counter
+    data.wrongAttempts = 0;                         // Reset wrong attempts
+    data.seed = seed;                               // Remember seed for replays
+    rng.reseed(seed);
+    journal = nullptr;                              // Moves are not journaled until attachJournal
+    generateSudoku();                               // Generate new puzzle
 }
 
 /**
  * Generates a playable Sudoku puzzle by removing numbers from solution
- * Removes 40-54 random numbers to create puzzle of varying difficulty
+ * Removes up to 40-54 random numbers to create puzzle of varying difficulty;
+ * a number is only removed if the puzzle keeps exactly one solution.
+ * The thread's generator runs on the game's engine state and hands it back,
+ * so each game keeps its own random sequence.
  */
 void SudokuGame::generateSudoku() 
 {
-    generateSolution();  // First create complete solution
+    detachJournal();
+    PuzzleGenerator& generator = threadGenerator();
+    generator.setEngine(rng);
+    generator.resetStats();
+    uint8_t puzzle[81];
+    generator.randomGame(data.solution, puzzle);  // Random solution, then remove clues keeping it unique
+    rng = generator.getEngine();
+    stats = generator.getStats();
+    setPuzzle(puzzle, gradePuzzle(puzzle).difficulty);
+}
 
-    // Initialize board with complete solution
-    for (int i = 0; i < 9; i++) 
+/**
+ * Starts play on a puzzle whose solution is already in data.solution, with
+ * an empty move history
+ * @param puzzle Givens in row-major order, 0 for empty cells
+ * @param difficulty Grade of the givens, kept for getDifficulty
+ */
+void SudokuGame::setPuzzle(const uint8_t puzzle[81], Difficulty difficulty) 
+{
+    data.difficulty = difficulty;
+    data.board.clear();
+    data.board.load(puzzle);
+    for (int cell = 0; cell < 81; cell++) 
     {
-        for (int j = 0; j < 9; j++) 
-        {
-            data.board[i][j] = data.solution[i][j];
-            data.fixed[i][j] = true;  // Mark all as fixed initially
-        }
+        data.board.setFixed(cell, puzzle[cell] != 0);  // Only clues stay fixed
     }
-    
-    // Remove random cells to create puzzle
-    srand(time(0));
-    int cellsToRemove = 40 + rand() % 15;  // Remove 40-54 numbers
-    while (cellsToRemove > 0) 
+    hints.load(puzzle);
+    hintsStale = false;
+    history.clear();
+}
+
+/**
+ * @param result Move outcome
+ * @return Short lowercase name ("correct", "conflict", ...)
+ */
+const char* moveResultName(MoveResult result)
+{
+    switch (result)
     {
-        int row = rand() % 9;
-        int col = rand() % 9;
-        if (data.board[row][col] != 0) 
-        {
-            data.board[row][col] = 0;      // Clear cell
-            data.fixed[row][col] = false;  // Mark as editable
-            cellsToRemove--;
-        }
+        case MOVE_CORRECT:      return "correct";
+        case MOVE_SOLVED:       return "solved";
+        case MOVE_FIXED:        return "fixed";
+        case MOVE_CONFLICT:     return "conflict";
+        case MOVE_WRONG:        return "wrong";
+        case MOVE_GAME_OVER:    return "gameover";
+        case MOVE_OUT_OF_RANGE: return "range";
+        default:                break;
     }
+    return "unknown";
 }
 
 /**
- * Prints the current state of the Sudoku board with formatting
- * Shows row/column headers and 3x3 box boundaries
+ * Checks a player's move and plays it if it matches the solution
+ * Applies the game rules in order: range, fixed cell, Sudoku conflict,
+ * solution compare (a wrong digit costs one of the allowed attempts)
+ * @param row Row (1-9)
+ * @param col Column (1-9)
+ * @param num Digit (1-9)
+ * @return Outcome of the move
  */
-void SudokuGame::printBoard() const 
+MoveResult SudokuGame::makeMove(int row, int col, int num) 
 {
-    cout << FG_CYAN << BOLD << "    1 2 3   4 5 6   7 8 9\n" << RESET;
-    cout << FG_GREEN << "  +-------+-------+-------+\n" << RESET;
-    
-    for (int i = 0; i < 9; i++) 
+    if (row < 1 || row > 9 || col < 1 || col > 9 || num < 1 || num > 9) return MOVE_OUT_OF_RANGE;
+    if (isGameOver()) return MOVE_GAME_OVER;
+
+    int cell = Board::index(row - 1, col - 1);
+    if (data.board.isFixed(cell)) return MOVE_FIXED;
+    if (!data.board.canPlace(cell, num)) return MOVE_CONFLICT;
+    if (num != data.solution[cell]) 
     {
-        if (i % 3 == 0 && i != 0) 
-        {
-            cout << FG_GREEN << "  +-------+-------+-------+\n" << RESET;
-        }
-        cout << FG_CYAN << BOLD << i+1 << RESET;
-        cout << FG_GREEN << " | " << RESET;
-        
-        for (int j = 0; j < 9; j++) 
-        {
-            if (j % 3 == 0 && j != 0) 
-            {
-                cout << FG_GREEN << "| " << RESET;
-            }
-            cout << (data.board[i][j] == 0 ? "." : to_string(data.board[i][j])) << " ";
-        }
-        cout << FG_GREEN << "|\n" << RESET;
+        data.wrongAttempts++;
+        recordMove(JOURNAL_WRONG, cell, num, 0);
+        return isGameOver() ? MOVE_GAME_OVER : MOVE_WRONG;
     }
-    cout << FG_GREEN << "  +-------+-------+-------+\n" << RESET;
+
+    updateBoard(row - 1, col - 1, num);
+    return isSolved() ? MOVE_SOLVED : MOVE_CORRECT;
 }
 
 /**
@@ -181,52 +165,42 @@ void SudokuGame::printBoard() const
  */
 bool SudokuGame::isValid(int row, int col, int num) const 
 {
-    // Check row and column for duplicates
-    for (int i = 0; i < 9; i++) 
-    {
-        if (data.board[row][i] == num || data.board[i][col] == num) 
-        {
-            return false;
-        }
-    }
-
-    // Check 3x3 box for duplicates
-    int boxRow = row - row % 3;
-    int boxCol = col - col % 3;
-    for (int i = 0; i < 3; i++) 
-    {
-        for (int j = 0; j < 3; j++) 
-        {
-            if (data.board[boxRow + i][boxCol + j] == num) 
-            {
-                return false;
-            }
-        }
-    }
-    return true;
+    // Row, column and box masks are kept up to date, so this is one lookup
+    return data.board.canPlace(Board::index(row, col), num);
 }
 
 /**
  * Provides a hint by revealing one correct number
- * Finds first empty cell and fills it with solution value
- * Limits to 2 hints per game
+ * Fills the next cell the hint engine can deduce and names the technique;
+ * falls back to the first empty cell if logic alone is stuck, with
+ * technique set to TECH_COUNT
+ * Limits to MAX_HINTS hints per game
+ * @param hint [out] Cell that was filled and the technique behind it
+ * @return False if no hints are left or the board is full
  */
-void SudokuGame::provideHint() 
+bool SudokuGame::provideHint(Hint& hint) 
 {
-    for (int i = 0; i < 9; i++) 
+    if (data.hintsUsed >= MAX_HINTS) return false;
+    if (hintsStale)
+    {
+        hints.load(data.board.cells);
+        hintsStale = false;
+    }
+    if (!hints.nextHint(hint)) 
     {
-        for (int j = 0; j < 9; j++)  
-        {
-            if (data.board[i][j] == 0 && !data.fixed[i][j])  
-            {
-                data.board[i][j] = data.solution[i][j];
-                data.fixed[i][j] = true;
-                data.hintsUsed++;
-                cout << FG_CYAN << "\n\n                                                        Hint placed at (" << i+1 << "," << j+1 << ")\n\n" << RESET;
-                return;
-            }
-        }
+        // Logic is stuck (or the player strayed); fall back to the first empty cell
+        for (hint.cell = 0; hint.cell < 81 && data.board.get(hint.cell) != 0; hint.cell++);
+        if (hint.cell == 81) return false;
+        hint.technique = TECH_COUNT;
     }
+
+    int cell = hint.cell;
+    int previous = data.board.get(cell);
+    hint.digit = data.solution[cell];
+    fixCell(cell, hint.digit);
+    data.hintsUsed++;
+    recordMove(JOURNAL_HINT, cell, hint.digit, previous);
+    return true;
 }
 
 /**
@@ -235,14 +209,16 @@ void SudokuGame::provideHint()
  */
 bool SudokuGame::isComplete() const 
 {
-    for (int i = 0; i < 9; i++) 
-    {
-        for (int j = 0; j < 9; j++) 
-        {
-            if (data.board[i][j] == 0) return false;
-        }
-    }
-    return true;
+    return data.board.isFull();
+}
+
+/**
+ * Checks the whole submitted board at once with the vectorized validator
+ * @return True if every row, column and box holds all nine digits
+ */
+bool SudokuGame::isSolved() const 
+{
+    return isSolvedGrid(data.board.cells);
 }
 
 /**
@@ -254,8 +230,24 @@ bool SudokuGame::isComplete() const
  */
 void SudokuGame::updateBoard(int row, int col, int num) 
 {
-    data.board[row][col] = num;
-    data.fixed[row][col] = true;
+    int cell = Board::index(row, col);
+    int previous = data.board.get(cell) | (data.board.isFixed(cell) ? DELTA_WAS_FIXED : 0);
+    fixCell(cell, num);
+    recordMove(JOURNAL_PLACE, cell, num, previous);
+}
+
+/**
+ * Places a digit, marks the cell fixed and updates the hint engine (unless
+ * it is reloaded before the next hint anyway)
+ * @param cell Cell index (0-80)
+ * @param num Number to place (1-9)
+ */
+void SudokuGame::fixCell(int cell, int num) 
+{
+    data.board.erase(cell);
+    data.board.set(cell, num);
+    data.board.setFixed(cell, true);
+    if (!hintsStale) hints.place(cell, num);
 }
 
 /**
@@ -264,6 +256,7 @@ void SudokuGame::updateBoard(int row, int col, int num)
 void SudokuGame::incrementWrongAttempts() 
 {
     data.wrongAttempts++;
+    recordMove(JOURNAL_WRONG, -1, 0, 0);
 }
 
 /**
@@ -282,6 +275,15 @@ int SudokuGame::getWrongAttempts() const
     return data.wrongAttempts;
 }
 
+/**
+ * @return True once the allowed wrong attempts are used up; further moves
+ *         are refused
+ */
+bool SudokuGame::isGameOver() const 
+{
+    return data.wrongAttempts >= MAX_WRONG_ATTEMPTS;
+}
+
 /**
  * Checks if cell is fixed (part of original puzzle or correct guess)
  * @param row Row index (0-8)
@@ -290,7 +292,18 @@ int SudokuGame::getWrongAttempts() const
  */
 bool SudokuGame::isFixed(int row, int col) const 
 {
-    return data.fixed[row][col];
+    return data.board.isFixed(Board::index(row, col));
+}
+
+/**
+ * Gets the player's board value for specified cell
+ * @param row Row index (0-8)
+ * @param col Column index (0-8)
+ * @return Number on the board at given position, 0 if empty
+ */
+int SudokuGame::getCell(int row, int col) const 
+{
+    return data.board.get(Board::index(row, col));
 }
 
 /**
@@ -301,94 +314,275 @@ bool SudokuGame::isFixed(int row, int col) const
  */
 int SudokuGame::getSolutionAt(int row, int col) const 
 {
-    return data.solution[row][col];
+    return data.solution[Board::index(row, col)];
 }
 
 /**
- * Displays the complete solution with formatting
+ * Saves current game state to a single-game binary save file
+ * @param filename Name of file to save to
+ * @return False if the file cannot be written
  */
-void SudokuGame::revealSolution() 
+bool SudokuGame::saveGame(const std::string& filename) const 
 {
-    cout << "\nSolution:\n";
-    for (int i = 0; i < 9; i++) 
-    {
-        for (int j = 0; j < 9; j++) 
-        {
-            cout << data.solution[i][j] << " ";
-            if (j % 3 == 2) cout << " ";
-        }
-        cout << "\n";
-        if (i % 3 == 2) cout << "\n";
-    }
+    SaveStore store;
+    return store.open(filename.c_str(), 1) && saveGame(store, 0) && store.flush();
 }
 
 /**
- * Saves current game state to file
- * @param filename Name of file to save to
+ * Loads game state from a binary save file
+ * @param filename Name of file to load from
+ * @return False if the file is missing or damaged; a new game is started
  */
-void SudokuGame::saveGame(const std::string& filename) const 
+bool SudokuGame::loadGame(const std::string& filename) 
 {
-    ofstream file(filename);
-    if (file.is_open()) 
-    {
-        // Save board state
-        for (int i = 0; i < 9; i++) 
-        {
-            for (int j = 0; j < 9; j++) 
-            {
-                file << data.board[i][j] << " ";
-            }
-            file << "\n";
-        }
-
-        // Save game metadata
-        file << data.hintsUsed << "\n";
-        file << data.wrongAttempts << "\n";
-        file.close();
-        std::cout << "Game saved to " << filename << "\n";
-    } 
-    else 
-    {
-        std::cout << "Error: Could not save game!\n";
-    }
+    SaveStore store;
+    if (store.open(filename.c_str(), 0) && loadGame(store, 0)) return true;
+
+    // Reset to new game if load fails
+    data.board.clear();
+    data.hintsUsed = 0;
+    data.wrongAttempts = 0;
+    generateSudoku();
+    return false;
 }
 
 /**
- * Loads game state from file
- * @param filename Name of file to load from
+ * Saves the game into a store slot: board, fixed cells, solution, counters
+ * and seed, packed into one fixed-size record
+ * @param store Open save store
+ * @param id Game ID (slot index)
+ * @return False if the store cannot take the record
  */
-void SudokuGame::loadGame(const std::string& filename) 
+bool SudokuGame::saveGame(SaveStore& store, uint64_t id) const 
 {
-    ifstream file(filename);
-    if (file.is_open()) 
+    return store.save(id, data);
+}
+
+/**
+ * Loads a game from a store slot; the saved solution is used as is, so no
+ * re-solve is needed
+ * @param store Open save store
+ * @param id Game ID (slot index)
+ * @return False if the slot is empty or damaged; the current game is kept
+ */
+bool SudokuGame::loadGame(const SaveStore& store, uint64_t id) 
+{
+    if (!store.load(id, data)) return false;
+    detachJournal();
+    hints.load(data.board.cells);
+    hintsStale = false;
+    history.clear();
+    return true;
+}
+
+/**
+ * Loads a journaled slot, including moves not yet compacted into the store
+ * @param moves Open journal
+ * @param id Game ID (slot index)
+ * @return False if the slot is empty or damaged; the current game is kept
+ */
+bool SudokuGame::loadGame(const MoveJournal& moves, uint64_t id) 
+{
+    if (!moves.load(id, data)) return false;
+    detachJournal();
+    hints.load(data.board.cells);
+    hintsStale = false;
+    history.clear();
+    return true;
+}
+
+/**
+ * Journals the game under a store slot: the current state becomes the
+ * slot's snapshot and every later move, hint and wrong attempt is appended
+ * to the journal as one small record, instead of rewriting the save
+ * @param moves Open journal
+ * @param id Game ID (slot index)
+ * @return False if the journal or store cannot take the snapshot
+ */
+bool SudokuGame::attachJournal(MoveJournal& moves, uint64_t id) 
+{
+    detachJournal();
+    uint32_t ticket = moves.snapshot(id, data);
+    if (ticket == 0) return false;
+    journal = &moves;
+    journalId = id;
+    journalTicket = ticket;
+    return true;
+}
+
+/**
+ * Stops journaling; the slot keeps the state of the last journaled move
+ */
+void SudokuGame::detachJournal() 
+{
+    journal = nullptr;
+}
+
+/**
+ * Appends a move to the journal; stops journaling if another game took
+ * over the slot or the journal was closed
+ * @param op Kind of move
+ * @param cell Cell index (0-80), -1 if none
+ * @param num Digit placed or tried
+ */
+void SudokuGame::journalMove(JournalOp op, int cell, int num) 
+{
+    if (journal && !journal->append(journalId, journalTicket, op, cell, num, data)) journal = nullptr;
+}
+
+/**
+ * Adds a placement or hint to the undo history as a 4-byte delta, then
+ * journals the move. Wrong attempts are journaled only: undo takes back
+ * board placements, never a count.
+ * @param op Kind of move
+ * @param cell Cell index (0-80), -1 if none
+ * @param num Digit placed or tried
+ * @param previous Digit the cell held before, with DELTA_WAS_FIXED if it
+ *        was fixed
+ */
+void SudokuGame::recordMove(JournalOp op, int cell, int num, int previous) 
+{
+    MoveDelta move;
+    move.op = op;
+    move.cell = cell < 0 ? 0xFF : cell;
+    move.digit = num;
+    move.previous = previous;
+    if (op != JOURNAL_WRONG) history.record(move);
+    journalMove(op, cell, num);
+}
+
+/**
+ * Plays a recorded move again or takes it back straight from its delta:
+ * nothing is checked against the solution or re-solved. Only the board
+ * changes; a hint stays counted after its cell is taken back and is not
+ * counted again when it is redone. Taking back a placement leaves the hint
+ * engine to be reloaded at the next hint.
+ * @param move Delta from the history
+ * @param forward True to play the move, false to take it back
+ */
+void SudokuGame::applyDelta(const MoveDelta& move, bool forward) 
+{
+    int cell = move.cell;
+    if (forward)
     {
-        // Load board state
-        for (int i = 0; i < 9; i++) 
-        {
-            for (int j = 0; j < 9; j++) 
-            {
-                file >> data.board[i][j];
-                data.fixed[i][j] = (data.board[i][j] != 0);
-            }
-        }
-
-        // Load game metadata
-        file >> data.hintsUsed;
-        file >> data.wrongAttempts;
-        file.close();
-        std::cout << "Game loaded from " << filename << "\n";
-        
-        // Regenerate solution for loaded puzzle
-        generateSolution();
-    } 
-    else 
+        fixCell(cell, move.digit);
+        journalMove((JournalOp)move.op, cell, move.digit);
+    }
+    else
     {
-        std::cout << "Error: Could not load game!\n";
-        // Reset to new game if load fails
-        std::memset(data.board, 0, sizeof(data.board));
-        std::memset(data.fixed, false, sizeof(data.fixed));
-        data.hintsUsed = 0;
-        data.wrongAttempts = 0;
-        generateSudoku();
+        int previous = move.previous & ~DELTA_WAS_FIXED;
+        data.board.erase(cell);
+        if (previous != 0) data.board.set(cell, previous);
+        data.board.setFixed(cell, (move.previous & DELTA_WAS_FIXED) != 0);
+        hintsStale = true;
     }
 }
+
+/**
+ * Journal records only move forward, so after moves are taken back a
+ * journaled game snapshots its slot again
+ */
+void SudokuGame::journalRestore() 
+{
+    if (journal) attachJournal(*journal, journalId);
+}
+
+/**
+ * Takes back the last placement: a placed digit or hint leaves its cell.
+ * Hints used and wrong attempts stay counted.
+ * @return False if there is no move to undo
+ */
+bool SudokuGame::undo() 
+{
+    MoveDelta move;
+    if (!history.undo(move)) return false;
+    applyDelta(move, false);
+    journalRestore();
+    return true;
+}
+
+/**
+ * Plays the last undone move again; any new move clears what can be redone
+ * @return False if there is no move to redo
+ */
+bool SudokuGame::redo() 
+{
+    MoveDelta move;
+    if (!history.redo(move)) return false;
+    applyDelta(move, true);
+    return true;
+}
+
+/**
+ * Names the current position so restoreBranch can return to it after
+ * exploring other moves; reusing a name moves the branch point
+ * @param name Branch point name
+ * @return False if the name is new and MAX_BRANCH_POINTS are in use
+ */
+bool SudokuGame::markBranch(const string& name) 
+{
+    return history.mark(name);
+}
+
+/**
+ * Returns to a branch point by taking back the moves since the common
+ * ancestor and replaying those up to the branch point; the line left
+ * behind stays in the history for other branch points
+ * @param name Branch point set by markBranch
+ * @return False if no branch point has that name
+ */
+bool SudokuGame::restoreBranch(const string& name) 
+{
+    bool tookBack = false;
+    bool found = history.restore(name, [&](const MoveDelta& move, bool forward) {
+        applyDelta(move, forward);
+        tookBack |= !forward;
+    });
+    if (tookBack) journalRestore();
+    return found;
+}
+
+/**
+ * @return Moves that undo can take back
+ */
+int SudokuGame::getUndoDepth() const 
+{
+    return history.undoDepth();
+}
+
+/**
+ * @return Undone moves that redo can play again
+ */
+int SudokuGame::getRedoDepth() const 
+{
+    return history.redoDepth();
+}
+
+/**
+ * @return Seed the current puzzle was generated from
+ */
+uint64_t SudokuGame::getSeed() const 
+{
+    return data.seed;
+}
+
+/**
+ * Grade of the current puzzle by the human techniques its givens require,
+ * taken when the puzzle started (or from the pool), so placed digits do
+ * not change it
+ * @return Difficulty of the original givens
+ */
+Difficulty SudokuGame::getDifficulty() const 
+{
+    return (Difficulty)data.difficulty;
+}
+
+/**
+ * @return Solver counters and phase times of this game's last puzzle
+ *         generation, zero for a pooled puzzle; all zero unless built with
+ *         SUDOKU_STATS
+ */
+const SolverStats& SudokuGame::getSolverStats() const 
+{
+    return stats;
+}
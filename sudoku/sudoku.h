@@ -1,47 +1,112 @@
 #ifndef SUDOKU_H
 #define SUDOKU_H
 
-#include <iostream>
 #include <cstring>
 #include <cstdlib>
 #include <ctime>
-#include <fstream>
+#include <cstdint>
 #include <string>
+#include "board.h"
+#include "solver.h"
+#include "generator.h"
+#include "grader.h"
+#include "pool.h"
+#include "history.h"
 using namespace std;
 
 // Stores all game data including board, fixed cells, hints, and solution
+// Packed and trivially copyable (256 bytes) so sessions can be snapshotted
+// and stored by plain copy
 struct GameData {
-    int board[9][9];
-    bool fixed[9][9];  
-    int hintsUsed;
-    int wrongAttempts;
-    int solution[9][9];
+    Board board;           // Player board, fixed cells and unit masks
+    uint8_t solution[81];  // Solved grid in row-major order
+    uint16_t hintsUsed;
+    uint16_t wrongAttempts;
+    uint64_t seed;         // Seed the puzzle was generated from
+    uint8_t difficulty;    // Grade of the givens (Difficulty), set with the puzzle
 };
 
+static_assert(std::is_trivially_copyable<GameData>::value, "GameData must stay snapshot-by-memcpy");
+static_assert(sizeof(GameData) <= 256, "GameData is copied by value into saves and snapshots");
+
+class SaveStore;
+class MoveJournal;
+enum JournalOp : uint8_t;
+
+const int MAX_HINTS = 2;                         // Hints allowed per game
+const int MAX_WRONG_ATTEMPTS = 3;                // Wrong moves that end the game
+
+// Outcome of one move; the game never prints, callers decide how to report it
+enum MoveResult {
+    MOVE_CORRECT,                                // Digit matches the solution and is now fixed
+    MOVE_SOLVED,                                 // Correct, and the board is complete
+    MOVE_FIXED,                                  // Cell already holds a fixed digit
+    MOVE_CONFLICT,                               // Digit repeats in the cell's row, column or box
+    MOVE_WRONG,                                  // Legal but not the solution; counts an attempt
+    MOVE_GAME_OVER,                              // Wrong attempts used up (now or earlier)
+    MOVE_OUT_OF_RANGE                            // Row, column or digit outside 1-9
+};
+
+const char* moveResultName(MoveResult result);   // Short lowercase name used in protocols and logs
+
+// Headless game session: puzzle generation, move checking, hints, saves.
+// Console output lives in the rendering layer (render.h). A session holds
+// its game state, random sequence, candidate grid and history; the generator
+// is per-thread scratch (sudoku.cpp), so the session arena stays small.
+
 class SudokuGame {
 private:
     GameData data;
-    bool solveSudoku();                          // Solves the puzzle using backtracking
-    bool findEmptyCell(int& row, int& col);      // Finds next empty cell coordinates
-    bool isValidPlacement(int row, int col, int num); // Checks if number fits in cell
-    void generateSolution();                     // Generates a complete valid solution
+    Xoshiro256 rng;                              // Game's random sequence, run on the thread's generator
+    HintEngine hints;                            // Candidate grid kept in step with the board
+    SolverStats stats;                           // Solver counters of the last generate, copied from the generator
+    MoveJournal* journal;                        // Journal every move goes to, nullptr if none
+    uint64_t journalId;                          // Save slot the moves are journaled under
+    uint32_t journalTicket;                      // Ticket from MoveJournal::snapshot
+    MoveHistory history;                         // Undo/redo tree of the moves since the puzzle started
+    bool hintsStale;                             // Hint engine missed moves taken back; reloaded on demand
+    void reset(uint64_t seed);                   // Clears state and generates a puzzle
+    void setPuzzle(const uint8_t puzzle[81], Difficulty difficulty); // Loads givens for the solution in data
+    void fixCell(int cell, int num);             // Places and fixes a digit without journaling it
+    void journalMove(JournalOp op, int cell, int num); // Appends a move to the journal, if any
+    void recordMove(JournalOp op, int cell, int num, int previous); // Adds a move to the history and the journal
+    void applyDelta(const MoveDelta& move, bool forward); // Plays a recorded move again or takes it back
+    void journalRestore();                       // Re-snapshots a journaled game after moves were taken back
 
 public:
-    SudokuGame();                                // Initializes new game
+    SudokuGame();                                // Initializes new game with a fresh seed
+    explicit SudokuGame(uint64_t seed);          // Initializes reproducible game
+    explicit SudokuGame(const PooledPuzzle& pooled); // Starts on a pre-generated puzzle
     void generateSudoku();                       // Creates new puzzle
-    void printBoard() const;                     // Displays current board
+    MoveResult makeMove(int row, int col, int num); // Checks and plays one move (1-based)
     bool isValid(int row, int col, int num) const; // Validates move
-    void provideHint();                          // Reveals one correct number
-    bool isComplete() const;                     // Checks if board is solved
+    bool provideHint(Hint& hint);                // Reveals one correct number
+    bool isComplete() const;                     // Checks if board is filled
+    bool isSolved() const;                       // Checks if board is filled and valid
     void updateBoard(int row, int col, int num); // Updates cell with new number
     void incrementWrongAttempts();               // Increases wrong attempts count
     int getHintsUsed() const;                    // Returns hints used count
     int getWrongAttempts() const;                // Returns wrong attempts count
-    void revealSolution();                       // Shows full solution
+    bool isGameOver() const;                     // True once wrong attempts are used up
     bool isFixed(int row, int col) const;        // Checks if cell is editable
+    int getCell(int row, int col) const;         // Gets board value for cell, 0 if empty
     int getSolutionAt(int row, int col) const;   // Gets solution value for cell
-    void saveGame(const string& filename) const; // Saves game to file
-    void loadGame(const string& filename);       // Loads game from file
+    bool saveGame(const string& filename) const; // Saves game to file
+    bool loadGame(const string& filename);       // Loads game from file, new game on failure
+    bool saveGame(SaveStore& store, uint64_t id) const; // Saves game to a store slot
+    bool loadGame(const SaveStore& store, uint64_t id); // Loads game from a store slot
+    bool loadGame(const MoveJournal& moves, uint64_t id); // Loads a journaled slot with its latest moves
+    bool attachJournal(MoveJournal& moves, uint64_t id); // Snapshots to a slot, then journals every move
+    void detachJournal();                        // Stops journaling moves
+    bool undo();                                 // Takes back the last placement; hints and wrong attempts stay counted
+    bool redo();                                 // Plays the last undone move again
+    bool markBranch(const string& name);         // Names the current position as a what-if branch point
+    bool restoreBranch(const string& name);      // Returns to a branch point, O(moves in between)
+    int getUndoDepth() const;                    // Moves that can be undone
+    int getRedoDepth() const;                    // Moves that can be redone
+    uint64_t getSeed() const;                    // Seed of the current puzzle
+    Difficulty getDifficulty() const;            // Logical grade of the givens, fixed when the puzzle starts
+    const SolverStats& getSolverStats() const;   // Counters of the game's last generate (SUDOKU_STATS)
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,89 @@
+#ifndef TABLES_H
+#define TABLES_H
+
+#include <cstdint>
+#include <type_traits>
+
+// Unit and peer lookup tables, generated at compile time. Hot loops walk
+// these flat arrays instead of recomputing rows, columns and boxes with
+// division and modulo on every call.
+
+template <int BOX>
+struct GridTraits {
+    static_assert(BOX >= 2 && BOX <= 5, "Supported box sizes are 2 to 5");
+
+    static constexpr int N = BOX * BOX;                  // Side length and number of digits
+    static constexpr int CELLS = N * N;
+    static constexpr int UNITS = 3 * N;                  // Rows, then columns, then boxes
+    static constexpr int PEERS = 3 * N - 2 * BOX - 1;    // Other cells sharing a unit (20 for 9x9)
+
+    typedef typename std::conditional<(N <= 16), uint16_t, uint32_t>::type Mask;   // Bit d-1 = digit d
+    typedef typename std::conditional<(CELLS <= 256), uint8_t, uint16_t>::type Index;
+    static constexpr Mask ALL_DIGITS = (Mask)((1ULL << N) - 1);
+};
+
+// Unit membership and peers of every cell
+template <int BOX>
+struct GridTables {
+    typedef GridTraits<BOX> T;
+    typename T::Index units[T::UNITS][T::N];             // Cells of each unit
+    typename T::Index peers[T::CELLS][T::PEERS];         // Peers of each cell
+    uint8_t cellUnits[T::CELLS][3];                      // Row, column and box of each cell
+};
+
+/**
+ * Builds the unit and peer tables at compile time
+ * @return Tables for the given box size
+ */
+template <int BOX>
+constexpr GridTables<BOX> makeGridTables()
+{
+    typedef GridTraits<BOX> T;
+    GridTables<BOX> tables = {};
+    for (int cell = 0; cell < T::CELLS; cell++)
+    {
+        int row = cell / T::N;
+        int col = cell % T::N;
+        int box = (row / BOX) * BOX + col / BOX;
+        tables.cellUnits[cell][0] = row;
+        tables.cellUnits[cell][1] = col;
+        tables.cellUnits[cell][2] = box;
+        tables.units[row][col] = cell;
+        tables.units[T::N + col][row] = cell;
+        tables.units[2 * T::N + box][(row % BOX) * BOX + col % BOX] = cell;
+    }
+    for (int cell = 0; cell < T::CELLS; cell++)
+    {
+        int count = 0;
+        for (int other = 0; other < T::CELLS; other++)
+        {
+            if (other == cell) continue;
+            bool sameRow = other / T::N == cell / T::N;
+            bool sameCol = other % T::N == cell % T::N;
+            bool sameBox = (other / T::N) / BOX == (cell / T::N) / BOX && (other % T::N) / BOX == (cell % T::N) / BOX;
+            if (sameRow || sameCol || sameBox) tables.peers[cell][count++] = other;
+        }
+    }
+    return tables;
+}
+
+template <int BOX>
+inline constexpr GridTables<BOX> gridTables = makeGridTables<BOX>();
+
+// The 9x9 tables used by Board, the solvers, the validator and the grader
+typedef GridTables<3> SudokuTables;
+inline constexpr const SudokuTables& sudokuTables = gridTables<3>;
+
+/**
+ * @param a Cell index (0-80)
+ * @param b Cell index (0-80)
+ * @return True if the cells share a row, column or box
+ */
+inline bool sharesUnit(int a, int b)
+{
+    const uint8_t* ua = sudokuTables.cellUnits[a];
+    const uint8_t* ub = sudokuTables.cellUnits[b];
+    return ua[0] == ub[0] || ua[1] == ub[1] || ua[2] == ub[2];
+}
+
+#endif
@@ -0,0 +1,164 @@
+#include "thread_pool.h"
+
+namespace {
+
+// Identifies the pool and worker slot of the calling thread
+thread_local const ThreadPool* currentPool = nullptr;
+thread_local int currentIndex = -1;
+
+}
+
+/**
+ * ThreadPool constructor - Starts the worker threads
+ * @param threadCount Number of workers (at least 1)
+ */
+ThreadPool::ThreadPool(int threadCount)
+    : pending(0), queued(0), nextWorker(0), stopping(false)
+{
+    if (threadCount < 1) threadCount = 1;
+    for (int i = 0; i < threadCount; i++)
+    {
+        workers.emplace_back(new Worker());
+    }
+    for (int i = 0; i < threadCount; i++)
+    {
+        threads.emplace_back(&ThreadPool::run, this, i);
+    }
+}
+
+/**
+ * ThreadPool destructor - Finishes queued work and joins the workers
+ */
+ThreadPool::~ThreadPool()
+{
+    wait();
+    {
+        std::lock_guard<std::mutex> guard(idleLock);
+        stopping = true;
+    }
+    wakeup.notify_all();
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+}
+
+/**
+ * Queues a task. Tasks submitted from a worker go to that worker's own
+ * deque (keeping related work on one core); others are spread round-robin.
+ * @param task Work to run; receives the executing worker's index
+ */
+void ThreadPool::submit(Task task)
+{
+    int index = currentWorker();
+    if (index < 0)
+    {
+        index = nextWorker.fetch_add(1, std::memory_order_relaxed) % workers.size();
+    }
+
+    pending.fetch_add(1, std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> guard(workers[index]->lock);
+        workers[index]->tasks.push_back(std::move(task));
+    }
+    {
+        std::lock_guard<std::mutex> guard(idleLock);
+        queued.fetch_add(1, std::memory_order_relaxed);
+    }
+    wakeup.notify_one();
+}
+
+/**
+ * Takes the most recently pushed task from the worker's own deque
+ * @param index Worker index
+ * @param task [out] Task taken
+ * @return True if a task was taken
+ */
+bool ThreadPool::popLocal(int index, Task& task)
+{
+    Worker& worker = *workers[index];
+    std::lock_guard<std::mutex> guard(worker.lock);
+    if (worker.tasks.empty()) return false;
+    task = std::move(worker.tasks.back());
+    worker.tasks.pop_back();
+    queued.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+}
+
+/**
+ * Takes the oldest task from the first other worker that has one
+ * @param index Index of the stealing worker
+ * @param task [out] Task taken
+ * @return True if a task was stolen
+ */
+bool ThreadPool::steal(int index, Task& task)
+{
+    int count = workers.size();
+    for (int offset = 1; offset < count; offset++)
+    {
+        Worker& victim = *workers[(index + offset) % count];
+        std::lock_guard<std::mutex> guard(victim.lock);
+        if (victim.tasks.empty()) continue;
+        task = std::move(victim.tasks.front());
+        victim.tasks.pop_front();
+        queued.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
+
+/**
+ * Worker loop: own deque first, then steal, then sleep until woken
+ * @param index Worker index
+ */
+void ThreadPool::run(int index)
+{
+    currentPool = this;
+    currentIndex = index;
+
+    Task task;
+    while (true)
+    {
+        if (popLocal(index, task) || steal(index, task))
+        {
+            task(index);
+            task = nullptr;
+            if (pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                std::lock_guard<std::mutex> guard(idleLock);
+                finished.notify_all();
+            }
+            continue;
+        }
+
+        std::unique_lock<std::mutex> guard(idleLock);
+        wakeup.wait(guard, [this] { return stopping || queued.load(std::memory_order_relaxed) > 0; });
+        if (stopping && queued.load(std::memory_order_relaxed) == 0) return;
+    }
+}
+
+/**
+ * Blocks until every submitted task has finished
+ * Must not be called from inside a task of the same pool
+ */
+void ThreadPool::wait()
+{
+    std::unique_lock<std::mutex> guard(idleLock);
+    finished.wait(guard, [this] { return pending.load(std::memory_order_acquire) == 0; });
+}
+
+/**
+ * @return Number of worker threads
+ */
+int ThreadPool::size() const
+{
+    return workers.size();
+}
+
+/**
+ * @return Index of the calling worker, or -1 if not called from this pool
+ */
+int ThreadPool::currentWorker() const
+{
+    return currentPool == this ? currentIndex : -1;
+}
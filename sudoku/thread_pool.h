@@ -0,0 +1,54 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Work-stealing thread pool
+// Every worker owns a deque: it pushes and pops its own work at the back,
+// while idle workers steal from the front of other deques. Tasks receive the
+// index of the worker running them so callers can keep per-thread scratch
+// state (RNG, solver) in a plain array indexed by worker.
+class ThreadPool {
+public:
+    typedef std::function<void(int)> Task;
+
+private:
+    struct Worker {
+        std::mutex lock;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<Worker> > workers;
+    std::vector<std::thread> threads;
+    std::atomic<long> pending;                   // Submitted but not finished
+    std::atomic<long> queued;                    // Sitting in a deque
+    std::atomic<unsigned> nextWorker;            // Round-robin target for outside submits
+    bool stopping;
+    std::mutex idleLock;
+    std::condition_variable wakeup;              // Signals queued work or shutdown
+    std::condition_variable finished;            // Signals pending reached zero
+
+    bool popLocal(int index, Task& task);        // Takes newest task from own deque
+    bool steal(int index, Task& task);           // Takes oldest task from another deque
+    void run(int index);                         // Worker loop
+
+public:
+    explicit ThreadPool(int threadCount);
+    ~ThreadPool();
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    void submit(Task task);                      // Queues a task
+    void wait();                                 // Blocks until every submitted task finished
+    int size() const;                            // Number of worker threads
+    int currentWorker() const;                   // Worker index of calling thread, -1 outside this pool
+};
+
+#endif